@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+
+# Compares the cycle counts from a performance test run against a stored
+# baseline & flags regressions. E.g.
+#
+#   pio test -e megaatmega2560-Os-sim -e megaatmega2560-O3-sim -f test_performance | tee perf.log
+#   python afd_perf_compare.py perf.log                 # compare against the baseline
+#   python afd_perf_compare.py perf.log --update        # make this run the new baseline
+#
+# The performance tests emit one AFD_CYCLES row per comparison (see
+# test/unity_print_timers.hpp). The environment is taken from the
+# "Processing <suite> in <env> environment" lines that pio test prints; use
+# --env for a log that doesn't have them (E.g. raw simavr output).
+#
+# simavr is cycle accurate, so the counts are deterministic: any increase in
+# the optimized (B) cycles beyond --tolerance is a regression. Exits with 1 if
+# there are any regressions.
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "test", "test_performance", "baseline.csv")
+
+COLUMNS = ["env", "test", "options", "dividend", "divisor", "cycles_a", "cycles_b"]
+KEY_COLUMNS = COLUMNS[:5]
+
+ENV_LINE = re.compile(r"Processing \S+ in (\S+) environment")
+CYCLES_LINE = re.compile(r"AFD_CYCLES,([^,\s]+),([^,\s]+),([^,\s]+),([^,\s]+),(\d+),(\d+)")
+
+def parse_log(lines, env_override):
+    rows = {}
+    env = env_override or "unknown"
+    for line in lines:
+        match = ENV_LINE.search(line)
+        if match and not env_override:
+            env = match.group(1)
+            continue
+        match = CYCLES_LINE.search(line)
+        if match:
+            test, options, dividend, divisor, cycles_a, cycles_b = match.groups()
+            rows[(env, test, options, dividend, divisor)] = (int(cycles_a), int(cycles_b))
+    return rows
+
+def read_csv(path):
+    rows = {}
+    with open(path, newline="") as csv_file:
+        for row in csv.DictReader(csv_file):
+            rows[tuple(row[column] for column in KEY_COLUMNS)] = (int(row["cycles_a"]), int(row["cycles_b"]))
+    return rows
+
+def write_csv(path, rows):
+    with open(path, "w", newline="") as csv_file:
+        writer = csv.writer(csv_file, lineterminator="\n")
+        writer.writerow(COLUMNS)
+        for key in sorted(rows):
+            writer.writerow(list(key) + list(rows[key]))
+
+def percent_change(old, new):
+    return 0.0 if old==0 else (new-old)*100.0/old
+
+def compare(baseline, current, tolerance):
+    # Only the environments in this run
+    envs = set(key[0] for key in current)
+    baseline = {key: value for key, value in baseline.items() if key[0] in envs}
+    regressions = 0
+    print(f"{'env':<28} {'test':<48} {'options':<20} {'base':>6} {'now':>6} {'change':>8}")
+    for key in sorted(set(baseline) | set(current)):
+        env, test, options, _, _ = key
+        if key not in current:
+            print(f"{env:<28} {test:<48} {options:<20} {baseline[key][1]:6d} {'-':>6}  missing")
+            continue
+        if key not in baseline:
+            print(f"{env:<28} {test:<48} {options:<20} {'-':>6} {current[key][1]:6d}  new")
+            continue
+        old = baseline[key][1]
+        new = current[key][1]
+        change = percent_change(old, new)
+        status = ""
+        if change>tolerance:
+            status = "  REGRESSION"
+            regressions += 1
+        elif change<-tolerance:
+            status = "  improved"
+        print(f"{env:<28} {test:<48} {options:<20} {old:6d} {new:6d} {change:+7.1f}%{status}")
+    return regressions
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare avr-fast-div performance test cycles against a baseline")
+    parser.add_argument("logs", nargs="*", help="pio test output. Reads stdin if omitted")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE, help="Baseline CSV (default: %(default)s)")
+    parser.add_argument("--env", help="Environment name for logs without pio's environment lines")
+    parser.add_argument("--tolerance", type=float, default=1.0, help="Allowed increase in cycles, in percent (default: %(default)s)")
+    parser.add_argument("--output", help="Also write the results of this run to a CSV")
+    parser.add_argument("--update", action="store_true", help="Merge the results of this run into the baseline instead of comparing")
+    args = parser.parse_args()
+
+    current = {}
+    if args.logs:
+        for log in args.logs:
+            with open(log, errors="replace") as log_file:
+                current.update(parse_log(log_file, args.env))
+    else:
+        current = parse_log(sys.stdin, args.env)
+
+    if not current:
+        print("No AFD_CYCLES rows found", file=sys.stderr)
+        return 1
+    if args.output:
+        write_csv(args.output, current)
+
+    if args.update:
+        baseline = read_csv(args.baseline) if os.path.exists(args.baseline) else {}
+        baseline.update(current)
+        write_csv(args.baseline, baseline)
+        print(f"Wrote {len(current)} rows to {args.baseline}")
+        return 0
+
+    if not os.path.exists(args.baseline):
+        # Annotate the CI run, so a missing baseline isn't mistaken for a pass
+        prefix = "::warning::" if os.environ.get("GITHUB_ACTIONS") else ""
+        print(f"{prefix}No baseline at {args.baseline}: run with --update to create it")
+        return 0
+
+    regressions = compare(read_csv(args.baseline), current, args.tolerance)
+    if regressions:
+        print(f"\n{regressions} cycle regression(s) above {args.tolerance}%")
+        return 1
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
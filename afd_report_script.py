@@ -0,0 +1,76 @@
+Import("env")
+
+# Adds an "afd_report" target that lists the flash size & own stack frame of each
+# public avr-fast-div function in the firmware. E.g.
+#
+#   pio run -e megaatmega2560-O3-device -t afd_report
+#
+# Flash sizes come from nm, so only functions that survive linking are listed:
+# inlined functions have no symbol of their own. Stack frames come from gcc's
+# -fstack-usage: they are the function's own frame, excluding its callees (avr-gcc
+# 7.3 has no -fcallgraph-info to sum the call graph with). The __afd_isr_* asm
+# kernels use no stack beyond the return address.
+#
+# This must be a pre: script. avr-fast-div is usually built as a library, & each
+# library is compiled with a clone of the global construction environment taken
+# before post: scripts run: flags added later, or to projenv, never reach it.
+
+import os
+import re
+import subprocess
+
+# The public API, demangled
+PUBLIC_API = re.compile(r"^(fast_\w+|avr_fast_div_impl::divide_fixed|__afd_isr_\w+|afd_profile_\w+)\b")
+
+env.Append(CCFLAGS=["-fstack-usage"])
+
+def flash_sizes(env, elf_path):
+    nm = re.sub(r"gcc$", "nm", env.subst("$CC"))
+    output = subprocess.check_output([nm, "--print-size", "--size-sort", "--demangle", elf_path], text=True)
+    sizes = []
+    for line in output.splitlines():
+        # address size type name
+        fields = line.split(None, 3)
+        if len(fields)==4 and fields[2].lower()=="t" and PUBLIC_API.match(fields[3]):
+            sizes.append((fields[3], int(fields[1], 16)))
+    return sizes
+
+def stack_frames(build_dir):
+    frames = []
+    for root, _, files in os.walk(build_dir):
+        for file in files:
+            if not file.endswith(".su"):
+                continue
+            with open(os.path.join(root, file)) as su_file:
+                for line in su_file:
+                    # file:line:column:function<TAB>bytes<TAB>qualifiers
+                    fields = line.rstrip("\n").split("\t")
+                    if len(fields)!=3:
+                        continue
+                    function = fields[0].split(":", 3)[-1]
+                    # gcc may prefix the return type
+                    name = re.sub(r"^.*?\b(?=(fast_|avr_fast_div_impl::|afd_profile_))", "", function)
+                    if PUBLIC_API.match(name):
+                        frames.append((name, int(fields[1]), fields[2]))
+    return sorted(set(frames))
+
+def afd_report(target, source, env):
+    elf_path = env.subst("$BUILD_DIR/${PROGNAME}.elf")
+    print("\nFlash (bytes)")
+    print("-------------")
+    sizes = flash_sizes(env, elf_path)
+    for name, size in sizes:
+        print(f"{size:6d}  {name}")
+    print(f"{sum(size for _, size in sizes):6d}  Total")
+
+    print("\nOwn stack frame (bytes, excluding callees)")
+    print("------------------------------------------")
+    for name, size, qualifiers in stack_frames(env.subst("$BUILD_DIR")):
+        print(f"{size:6d}  {name} ({qualifiers})")
+
+env.AddCustomTarget(
+    name="afd_report",
+    dependencies="$BUILD_DIR/${PROGNAME}.elf",
+    actions=afd_report,
+    title="AFD Report",
+    description="Flash size & own stack frame of each avr-fast-div public function")
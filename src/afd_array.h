@@ -0,0 +1,80 @@
+#pragma once
+
+/** @file
+ * @brief Division of whole arrays. See @ref group-afd-array
+*/
+
+#include <stddef.h>
+#include "avr-fast-div.h"
+#include "afd_divisor.h"
+
+/// @defgroup group-afd-array Array division
+///
+/// @brief Divide a buffer of values in one call.
+///
+/// When all elements share a divisor, the zero check and divisor setup are done
+/// once per array (by building an afd_divisor), rather than once per element. 
+///
+/// Usage:
+/// @code
+///      fast_div_array(adcSamples, sampleScale, scaledSamples, SAMPLE_COUNT);
+/// @endcode
+///
+/// @note Results are identical to calling fast_div() on each element.
+/// @{
+
+namespace avr_fast_div_impl {
+
+  /// @brief The afd_divisor type used to divide a TDividend by a TDivisor.
+  ///
+  /// afd_divisor<uint8_t> only divides 16-bit values, so 32-bit dividends
+  /// need at least a 16-bit divisor
+  template <typename TDividend, typename TDivisor>
+  struct array_divisor {
+    static_assert(type_traits::is_signed<TDividend>::value==type_traits::is_signed<TDivisor>::value, "Dividend & divisor must have the same signedness");
+    static_assert(sizeof(TDividend)<=sizeof(uint32_t), "Dividend type must be 32-bits or less");
+    static_assert(sizeof(TDivisor)<=sizeof(TDividend), "Divisor type must be no wider than the dividend type");
+
+    using udivisor_t = type_traits::conditional_t<(sizeof(TDividend)>sizeof(uint16_t)) && (sizeof(TDivisor)<sizeof(uint16_t)), 
+                                                  uint16_t, 
+                                                  type_traits::make_unsigned_t<TDivisor>>;
+    using type = afd_divisor<type_traits::conditional_t<type_traits::is_signed<TDivisor>::value, 
+                                                        type_traits::make_signed_t<udivisor_t>, 
+                                                        udivisor_t>>;
+  };
+
+}
+
+/// @brief Divide every element of an array by the same divisor
+///
+/// @tparam TDividend Any 8, 16 or 32-bit integer type
+/// @tparam TDivisor Integer type, no wider than TDividend & same signedness
+/// @tparam TResult Result element type
+/// @param pDividends The dividends (numerators)
+/// @param divisor The divisor (denominator)
+/// @param pResults Receives pDividends[i]/divisor. May be the same as pDividends
+/// @param count Number of elements
+template <typename TDividend, typename TDivisor, typename TResult>
+static inline void fast_div_array(const TDividend *pDividends, TDivisor divisor, TResult *pResults, size_t count) {
+  using divisor_t = typename avr_fast_div_impl::array_divisor<TDividend, TDivisor>::type;
+  using dividend_t = typename divisor_t::dividend_t;
+  const divisor_t precomputed((typename divisor_t::divisor_t)divisor);
+  for (size_t index=0U; index<count; ++index) {
+    pResults[index] = (TResult)precomputed.divide((dividend_t)pDividends[index]);
+  }
+}
+
+/// @brief Divide an array element-wise by another array
+///
+/// @param pDividends The dividends (numerators)
+/// @param pDivisors The divisors (denominators)
+/// @param pResults Receives pDividends[i]/pDivisors[i]. May be the same as pDividends
+/// @param count Number of elements
+template <typename TDividend, typename TDivisor, typename TResult>
+static inline void fast_div_array(const TDividend *pDividends, const TDivisor *pDivisors, TResult *pResults, size_t count) {
+  for (size_t index=0U; index<count; ++index) {
+    pResults[index] = (TResult)fast_div(pDividends[index], pDivisors[index]);
+  }
+}
+
+/// @}
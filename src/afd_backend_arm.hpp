@@ -0,0 +1,139 @@
+#pragma once
+
+// The ARM division backends: AFD_BACKEND_ARMV6M & AFD_BACKEND_RP2040. Both override
+// the narrow result kernels, divide_rem_quot(), that the rest of
+// afd_implementation.hpp (& so the fast_div() dispatch) is built on. RP2040 also
+// routes the large divisor kernels to the SIO divider. Everything else uses the
+// division operator (AFD_NATIVE_FALLBACK): the portable C models are bit loops,
+// slower than the runtime library.
+//
+// The kernels return the same packed rem:quot value as the AVR assembly: the
+// quotient in the lower half, the remainder in the upper half.
+
+#include "avr-fast-div.h"
+
+#if defined(AFD_BACKEND_RP2040)
+#include "hardware/divider.h"
+#endif
+
+namespace avr_fast_div_impl {
+
+#if defined(AFD_BACKEND_RP2040)
+
+// One division on the SIO divider. Not safe to interrupt: see divmod_sio()
+static inline afd_divmod_t<uint32_t, uint32_t> divmod_sio_start_wait(uint32_t dividend, uint32_t divisor) {
+  hw_divider_divmod_u32_start(dividend, divisor);
+  // The remainder is read first: reading the quotient clears the DIRTY flag
+  const uint32_t rem = hw_divider_u32_remainder_wait();
+  return { hw_divider_u32_quotient_wait(), rem };
+}
+
+// Divide using the SIO hardware divider: 8 cycles, for any 32-bit operands.
+//
+// Each core has one divider, shared by all code running on it. So an ISR that
+// divides while the interrupted code is between writing the operands & reading
+// the quotient would corrupt that division. The DIRTY flag is set over exactly
+// that window. So if it is set on entry, this call interrupted a division (the
+// library's, the SDK's or the application's): save the divider's state first &
+// restore it after, as the SDK's own division routines do. Otherwise the only
+// overhead is reading SIO_DIV_CSR.
+static inline afd_divmod_t<uint32_t, uint32_t> divmod_sio(uint32_t dividend, uint32_t divisor) {
+  if ((sio_hw->div_csr & SIO_DIV_CSR_DIRTY_BITS)==0U) {
+    return divmod_sio_start_wait(dividend, divisor);
+  }
+  hw_divider_state_t interrupted;
+  // The interrupted division may not have finished yet
+  hw_divider_wait_ready();
+  hw_divider_save_state(&interrupted);
+  const afd_divmod_t<uint32_t, uint32_t> result = divmod_sio_start_wait(dividend, divisor);
+  hw_divider_restore_state(&interrupted);
+  return result;
+}
+
+// uint32_t/uint16_t => uint16_t quotient + uint16_t remainder
+static inline uint32_t divide_rem_quot(uint32_t dividend, const uint16_t &divisor) {
+  const afd_divmod_t<uint32_t, uint32_t> result = divmod_sio(dividend, divisor);
+  return (result.rem << 16U) | (uint16_t)result.quot;
+}
+
+// uint16_t/uint8_t => uint8_t quotient + uint8_t remainder
+static inline uint16_t divide_rem_quot(uint16_t dividend, const uint8_t &divisor) {
+  const afd_divmod_t<uint32_t, uint32_t> result = divmod_sio(dividend, divisor);
+  return (uint16_t)((result.rem << 8U) | (uint8_t)result.quot);
+}
+
+#elif defined(AFD_BACKEND_ARMV6M)
+
+// Cortex-M0/M0+ have no divide instruction, so libgcc's __aeabi_uidiv computes all
+// 32 quotient bits. As on AVR, when the quotient is known to fit into the lower
+// half only those bits need computing.
+//
+// rem:quot occupy the top bits of one register, so the shift out of the top is
+// the remainder overflow & comparing the whole register compares the remainder.
+// The quotient bit is folded into the subtraction: subtracting
+// (divisor<<n)-(1<<m) subtracts the divisor from the remainder & sets the
+// quotient bit in one instruction.
+//
+// Either fully unrolled (the default), or with AFD_SMALL_KERNELS a subs/bne loop.
+#if defined(AFD_SMALL_KERNELS)
+#define AFD_DIVIDE_LOOP_BEGIN(count) "    movs %1, #" #count " @ loop counter\n\t" \
+                                     "3:\n\t"
+#define AFD_DIVIDE_LOOP_END          "    subs %1, %1, #1 @ next\n\t" \
+                                     "    bne  3b         @  bit\n\t"
+#else
+#define AFD_DIVIDE_LOOP_BEGIN(count) ".rept " #count "\n\t"
+#define AFD_DIVIDE_LOOP_END          ".endr\n\t"
+#endif
+
+#define AFD_DIVIDE_STEP \
+        "    lsls %0, %0, #1 @ shift rem:quot left by 1\n\t" \
+        "    bcs  1f         @ if carry out, rem > divisor\n\t" \
+        "    cmp  %0, %2     @ is rem less than divisor?\n\t" \
+        "    bcc  2f         @ yes, when carry clear\n\t" \
+        "1:\n\t" \
+        "    subs %0, %0, %3 @ rem -= divisor, quotient bit = 1\n\t" \
+        "2:\n\t"
+
+// uint32_t/uint16_t => uint16_t quotient + uint16_t remainder
+static inline uint32_t divide_rem_quot(uint32_t dividend, const uint16_t &divisor) {
+  const uint32_t alignedDivisor = (uint32_t)divisor << 16U;
+  const uint32_t subtrahend = alignedDivisor - 1U;
+  uint32_t counter;
+  asm(
+      AFD_DIVIDE_LOOP_BEGIN(16)
+      AFD_DIVIDE_STEP
+      AFD_DIVIDE_LOOP_END
+    : "+l" (dividend), "=&l" (counter)
+    : "l" (alignedDivisor), "l" (subtrahend)
+    : "cc"
+  );
+  (void)counter;
+  return dividend;
+}
+
+// uint16_t/uint8_t => uint8_t quotient + uint8_t remainder. rem:quot are
+// placed in the upper half of the register
+static inline uint16_t divide_rem_quot(uint16_t dividend, const uint8_t &divisor) {
+  uint32_t remQuot = (uint32_t)dividend << 16U;
+  const uint32_t alignedDivisor = (uint32_t)divisor << 24U;
+  const uint32_t subtrahend = alignedDivisor - ((uint32_t)1U << 16U);
+  uint32_t counter;
+  asm(
+      AFD_DIVIDE_LOOP_BEGIN(8)
+      AFD_DIVIDE_STEP
+      AFD_DIVIDE_LOOP_END
+    : "+l" (remQuot), "=&l" (counter)
+    : "l" (alignedDivisor), "l" (subtrahend)
+    : "cc"
+  );
+  (void)counter;
+  return (uint16_t)(remQuot >> 16U);
+}
+
+#undef AFD_DIVIDE_LOOP_BEGIN
+#undef AFD_DIVIDE_LOOP_END
+#undef AFD_DIVIDE_STEP
+
+#endif
+
+}
@@ -0,0 +1,387 @@
+#pragma once
+
+/** @file
+ * @brief Division by a runtime invariant divisor. See @ref group-afd-divisor
+*/
+
+#include "avr-fast-div.h"
+#if defined(USE_OPTIMIZED_DIV)
+#include "afd_implementation.hpp"
+#endif
+
+/// @defgroup group-afd-divisor Division by a runtime invariant divisor
+///
+/// @brief Optimised division when the divisor changes rarely, but isn't a compile time constant.
+///
+/// The setup cost is paid once, when the afd_divisor is constructed: a multiplicative
+/// inverse of the divisor is computed. Each division is then a multiply-high, one
+/// add and two shifts, rather than a bit-by-bit division loop.
+///
+/// See Granlund & Montgomery, "Division by Invariant Integers using Multiplication" (figure 4.1)
+///
+/// Usage:
+/// @code
+///      const afd_divisor<uint16_t> divisor(toothDeltaT);
+///      for (uint8_t index=0; index<count; ++index) {
+///        results[index] = fast_div(values[index], divisor);
+///      }
+/// @endcode
+///
+/// @note Results are identical to fast_div(), including a zero divisor.
+/// @note On AVR, the multiply-high is compiled to the hardware ```mul``` instruction
+/// (via the libgcc widening multiply helpers, E.g. __umulhisi3). The 32-bit
+/// multiply-high is 4 16x16=>32 partial products, not a 64-bit multiply.
+/// @{
+
+namespace avr_fast_div_impl {
+
+  /// @brief Maps a divisor type to the dividend type it can divide
+  template <typename TDivisor>
+  struct divisor_traits;
+
+  template <>
+  struct divisor_traits<uint8_t> { typedef uint16_t dividend_t; };
+
+  template <>
+  struct divisor_traits<uint16_t> { typedef uint32_t dividend_t; };
+
+  template <>
+  struct divisor_traits<uint32_t> { typedef uint32_t dividend_t; };
+
+#if defined(USE_OPTIMIZED_DIV)
+
+  /// @brief Maps a type to the next wider type (for widening multiplication)
+  template <typename T>
+  struct wide_type;
+
+  template <>
+  struct wide_type<uint8_t> { typedef uint16_t type; };
+
+  template <>
+  struct wide_type<uint16_t> { typedef uint32_t type; };
+
+  template <>
+  struct wide_type<uint32_t> { typedef uint64_t type; };
+
+  /// @brief The upper half of the full width product a*b
+  template <typename T>
+  static inline T mul_high(T a, T b) {
+    using wide_t = typename wide_type<T>::type;
+    return (T)(((wide_t)a * (wide_t)b) >> (sizeof(T) * CHAR_BIT));
+  }
+
+#if defined(AFD_BACKEND_AVR) || defined(AFD_BACKEND_C_MODEL)
+  /// @brief As above, for uint32_t. avr-gcc would compute the full 64-bit product
+  /// (__muldi3): instead, sum 4 16x16=>32 partial products
+  static inline uint32_t mul_high(uint32_t a, uint32_t b) {
+    const uint16_t a0 = (uint16_t)a;
+    const uint16_t a1 = (uint16_t)(a >> 16U);
+    const uint16_t b0 = (uint16_t)b;
+    const uint16_t b1 = (uint16_t)(b >> 16U);
+    const uint32_t low = multiply(a0, b0);
+    const uint32_t cross0 = multiply(a0, b1);
+    const uint32_t cross1 = multiply(a1, b0);
+    // The middle word of the product: its carry is the only part of the lower half we need
+    const uint32_t middle = (low >> 16U) + (uint16_t)cross0 + (uint16_t)cross1;
+    return multiply(a1, b1) + (cross0 >> 16U) + (cross1 >> 16U) + (middle >> 16U);
+  }
+#endif
+
+  /// @brief ceil(log2(value)).
+  /// @note By definition, log2(0) is undefined: this returns 0
+  template <typename T>
+  static inline uint8_t ceil_log2(T value) {
+    uint8_t log2 = 0U;
+    if (value!=0U) {
+      value = (T)(value-1U);
+      while (value!=0U) {
+        ++log2;
+        value = (T)(value>>1U);
+      }
+    }
+    return log2;
+  }
+
+#endif
+
+}
+
+template <typename TDivisor, bool isSigned = type_traits::is_signed<TDivisor>::value>
+class afd_divisor;
+
+/// @brief A precomputed unsigned divisor
+///
+/// @tparam TDivisor One of uint8_t, uint16_t or uint32_t
+template <typename TDivisor>
+class afd_divisor<TDivisor, false> {
+public:
+  /// @brief The divisor type
+  using divisor_t = TDivisor;
+  /// @brief The dividend (and quotient) type
+  using dividend_t = typename avr_fast_div_impl::divisor_traits<TDivisor>::dividend_t;
+
+  /// @brief Construct from a divisor: this is the expensive part
+  explicit afd_divisor(TDivisor divisor)
+    : _divisor(divisor)
+  {
+#if defined(USE_OPTIMIZED_DIV)
+    constexpr uint8_t width = sizeof(dividend_t) * CHAR_BIT;
+    if (divisor==0U) {
+      // Matches AFD_ZERO_DIVISOR_CHECK: (0 + (dividend>>1)) >> (width-1) == 0
+      _multiplier = 0U;
+      _shift1 = 1U;
+      _shift2 = (uint8_t)(width-1U);
+    } else {
+      const uint8_t log2 = avr_fast_div_impl::ceil_log2(divisor);
+      using wide_t = typename avr_fast_div_impl::wide_type<dividend_t>::type;
+      // m = floor(2^width * (2^log2 - divisor) / divisor) + 1
+      // Since (2^log2 - divisor)<divisor, this always fits into dividend_t. So
+      // fast_div() uses a narrow kernel, E.g. u64/u32=>u32 instead of __udivmoddi4
+      const wide_t numerator = (wide_t)((((wide_t)1U << log2) - divisor) << width);
+      _multiplier = (dividend_t)(fast_div(numerator, divisor) + 1U);
+      _shift1 = log2>0U ? 1U : 0U;
+      _shift2 = log2>0U ? (uint8_t)(log2-1U) : 0U;
+    }
+#endif
+  }
+
+  /// @brief Divide a value by this divisor
+  /// @param dividend The dividend (numerator)
+  /// @return dividend/divisor()
+  dividend_t divide(dividend_t dividend) const {
+#if defined(USE_OPTIMIZED_DIV)
+    const dividend_t high = avr_fast_div_impl::mul_high(_multiplier, dividend);
+    // Since high<=dividend, this cannot overflow
+    return (dividend_t)((dividend_t)(high + (dividend_t)((dividend_t)(dividend - high) >> _shift1)) >> _shift2);
+#else
+    return (dividend_t)(dividend / _divisor);
+#endif
+  }
+
+  /// @brief The divisor that this object was constructed from
+  TDivisor divisor(void) const {
+    return _divisor;
+  }
+
+private:
+  TDivisor _divisor;
+#if defined(USE_OPTIMIZED_DIV)
+  dividend_t _multiplier;
+  uint8_t _shift1;
+  uint8_t _shift2;
+#endif
+};
+
+/// @brief A precomputed signed divisor
+///
+/// @tparam TDivisor One of int8_t, int16_t or int32_t
+template <typename TDivisor>
+class afd_divisor<TDivisor, true> {
+  using udivisor_t = type_traits::make_unsigned_t<TDivisor>;
+  using udividend_t = typename afd_divisor<udivisor_t>::dividend_t;
+
+public:
+  /// @brief The divisor type
+  using divisor_t = TDivisor;
+  /// @brief The dividend (and quotient) type
+  using dividend_t = type_traits::make_signed_t<udividend_t>;
+
+  /// @brief Construct from a divisor: this is the expensive part
+  explicit afd_divisor(TDivisor divisor)
+    : _udivisor(avr_fast_div_impl::safe_abs(divisor))
+    , _isNegative(divisor<0)
+  {
+  }
+
+  /// @brief Divide a value by this divisor
+  /// @param dividend The dividend (numerator)
+  /// @return dividend/divisor()
+  dividend_t divide(dividend_t dividend) const {
+    udividend_t uresult = _udivisor.divide(avr_fast_div_impl::safe_abs(dividend));
+    if ((dividend<0) != _isNegative) {
+      return (dividend_t)-((dividend_t)uresult);
+    }
+    return (dividend_t)uresult;
+  }
+
+  /// @brief The divisor that this object was constructed from
+  TDivisor divisor(void) const {
+    return _isNegative ? (TDivisor)-((TDivisor)_udivisor.divisor()) : (TDivisor)_udivisor.divisor();
+  }
+
+private:
+  afd_divisor<udivisor_t> _udivisor;
+  bool _isNegative;
+};
+
+/// @defgroup group-afd-divisor-overloads Division by a precomputed divisor
+/// @{
+
+static inline uint16_t fast_div(uint16_t udividend, const afd_divisor<uint8_t> &udivisor) {
+  return udivisor.divide(udividend);
+}
+static inline uint32_t fast_div(uint32_t udividend, const afd_divisor<uint16_t> &udivisor) {
+  return udivisor.divide(udividend);
+}
+static inline uint32_t fast_div(uint32_t udividend, const afd_divisor<uint32_t> &udivisor) {
+  return udivisor.divide(udividend);
+}
+static inline int16_t fast_div(int16_t dividend, const afd_divisor<int8_t> &divisor) {
+  return divisor.divide(dividend);
+}
+static inline int32_t fast_div(int32_t dividend, const afd_divisor<int16_t> &divisor) {
+  return divisor.divide(dividend);
+}
+static inline int32_t fast_div(int32_t dividend, const afd_divisor<int32_t> &divisor) {
+  return divisor.divide(dividend);
+}
+
+/// @}
+
+/// @}
+
+/// @defgroup group-afd-constant-divisor Division by a compile time constant
+///
+/// @brief Optimised division when the divisor is a compile time constant.
+///
+/// The division strategy is selected at compile time, so there are no range or 
+/// zero checks at run time:
+///  1. Power of 2: a shift
+///  2. Otherwise a constant multiply-high & shift (plus an add if the multiplier 
+///     needs an extra bit)
+///
+/// Usage:
+/// @code
+///      rpm = fast_div<6U>(revolutionTime);
+/// @endcode
+/// @{
+
+namespace avr_fast_div_impl {
+
+  /// @brief ceil(log2(value)) at compile time. Returns 0 for 0 & 1
+  static constexpr uint8_t ceil_log2_c(uint64_t value) {
+    return value<=1U ? 0U : (uint8_t)(1U + ceil_log2_c((value+1U)/2U));
+  }
+
+  /// @brief Compile time constants for division of a T by divisor
+  template <typename T, uint32_t divisor>
+  struct constant_divisor {
+    static_assert(type_traits::is_unsigned<T>::value, "T must be unsigned");
+    static_assert(divisor!=0U, "Division by zero");
+
+    // Dividend bit width
+    static constexpr uint8_t width = sizeof(T) * CHAR_BIT;
+    // ceil(log2(divisor))
+    static constexpr uint8_t log2 = ceil_log2_c(divisor);
+    static constexpr bool is_pow2 = (divisor & (divisor-1U))==0U;
+    static constexpr bool is_too_large = (uint64_t)divisor>(uint64_t)(T)-1;
+    // Post multiply shift. Only applies if !is_pow2, so log2>1
+    static constexpr uint8_t shift = is_pow2 ? 0U : (uint8_t)(log2-1U);
+
+    // Multiplier for a single multiply-high: ceil(2^(width+shift)/divisor).
+    // This always fits into a T...
+    static constexpr uint64_t simple_multiplier = is_pow2 ? 0U : (((uint64_t)1U << (width+shift)) / divisor) + 1U;
+    // ...but is only exact for all dividends if the rounding error is small enough.
+    // See Granlund & Montgomery, theorem 4.2
+    static constexpr bool is_simple = !is_pow2 && ((simple_multiplier*divisor) - ((uint64_t)1U << (width+shift))) <= ((uint64_t)1U << shift);
+
+    // Otherwise we use the same multiplier as afd_divisor
+    static constexpr uint64_t fixup_multiplier = is_pow2 ? 0U : 
+      (((((uint64_t)1U << log2) - divisor) << width) / divisor) + 1U;
+  };
+
+  enum constant_divide_strategy : uint8_t {
+    constant_divide_zero,
+    constant_divide_shift,
+    constant_divide_mul_high,
+    constant_divide_mul_high_fixup,
+  };
+
+  template <typename T, uint32_t divisor>
+  struct constant_divide_strategy_of {
+    using traits = constant_divisor<T, divisor>;
+    static constexpr constant_divide_strategy value = 
+      traits::is_too_large ? constant_divide_zero :
+      traits::is_pow2 ? constant_divide_shift :
+      traits::is_simple ? constant_divide_mul_high : constant_divide_mul_high_fixup;
+  };
+
+  template <typename T, uint32_t divisor, constant_divide_strategy strategy = constant_divide_strategy_of<T, divisor>::value>
+  struct constant_divide;
+
+  template <typename T, uint32_t divisor>
+  struct constant_divide<T, divisor, constant_divide_zero> {
+    static inline T divide(T) {
+      return 0U;
+    }
+  };
+
+  template <typename T, uint32_t divisor>
+  struct constant_divide<T, divisor, constant_divide_shift> {
+    static inline T divide(T dividend) {
+      return (T)(dividend >> constant_divisor<T, divisor>::log2);
+    }
+  };
+
+  template <typename T, uint32_t divisor>
+  struct constant_divide<T, divisor, constant_divide_mul_high> {
+    static inline T divide(T dividend) {
+#if defined(USE_OPTIMIZED_DIV)
+      using traits = constant_divisor<T, divisor>;
+      return (T)(mul_high((T)traits::simple_multiplier, dividend) >> traits::shift);
+#else
+      return (T)(dividend / divisor);
+#endif
+    }
+  };
+
+  template <typename T, uint32_t divisor>
+  struct constant_divide<T, divisor, constant_divide_mul_high_fixup> {
+    static inline T divide(T dividend) {
+#if defined(USE_OPTIMIZED_DIV)
+      using traits = constant_divisor<T, divisor>;
+      const T high = mul_high((T)traits::fixup_multiplier, dividend);
+      // Since high<=dividend, this cannot overflow
+      return (T)((T)(high + (T)((T)(dividend - high) >> 1U)) >> traits::shift);
+#else
+      return (T)(dividend / divisor);
+#endif
+    }
+  };
+
+  template <typename TDividend, uint32_t divisor, bool isSigned = type_traits::is_signed<TDividend>::value>
+  struct constant_divide_signed;
+
+  template <typename TDividend, uint32_t divisor>
+  struct constant_divide_signed<TDividend, divisor, false> {
+    static inline TDividend divide(TDividend dividend) {
+      return constant_divide<TDividend, divisor>::divide(dividend);
+    }
+  };
+
+  template <typename TDividend, uint32_t divisor>
+  struct constant_divide_signed<TDividend, divisor, true> {
+    static inline TDividend divide(TDividend dividend) {
+      using udividend_t = type_traits::make_unsigned_t<TDividend>;
+      udividend_t uresult = constant_divide<udividend_t, divisor>::divide(safe_abs(dividend));
+      if (dividend<0) {
+        return (TDividend)-((TDividend)uresult);
+      }
+      return (TDividend)uresult;
+    }
+  };
+
+}
+
+/// @brief Division by a compile time constant
+///
+/// @tparam divisor The divisor (denominator). Must be non-zero & positive.
+/// @tparam TDividend Any 8, 16 or 32-bit integer type
+/// @param dividend The dividend (numerator)
+/// @return dividend/divisor
+template <uint32_t divisor, typename TDividend>
+static inline TDividend fast_div(TDividend dividend) {
+  return avr_fast_div_impl::constant_divide_signed<TDividend, divisor>::divide(dividend);
+}
+
+/// @}
@@ -1,5 +1,53 @@
 #pragma once
 #include "type_traits.h"
+#include "avr-fast-div.h"
+
+#if defined(AFD_RECIPROCAL_TABLE) || defined(AFD_NEWTON_RAPHSON)
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#define AFD_PROGMEM PROGMEM
+#else
+#define AFD_PROGMEM
+#endif
+#endif
+
+#if defined(AFD_BACKEND_ARMV6M) || defined(AFD_BACKEND_RP2040)
+#include "afd_backend_arm.hpp"
+/// @brief The kernels afd_backend_arm.hpp doesn't override use the division operator:
+/// the C models would be slower than the runtime library (on RP2040, the SIO divider)
+#define AFD_NATIVE_FALLBACK
+#endif
+
+#if !defined(AFD_ZERO_DIVISOR_CHECK)
+/**
+ * @brief Check for zero divisor
+ * 
+ * Defaults to AVR behavior - return zero. However, this macro can
+ * be pre-defined by the host code base if you want different behavior.
+ * E.g. abort(), throw exception 
+ *
+ * @param dividend The dividend (numerator)
+ * @param divisor The divisor (denominator)
+ * @return dividend/divisor
+ */
+#define AFD_ZERO_DIVISOR_CHECK(dividend, divisor) \
+  if ((divisor)==0U) { return 0U; }
+#endif
+
+#if !defined(AFD_ZERO_DIVISOR_CHECK_DIVMOD)
+/**
+ * @brief Check for zero divisor in the fast_divmod() family
+ * 
+ * As AFD_ZERO_DIVISOR_CHECK: defaults to returning zero for both
+ * quotient & remainder. 
+ *
+ * @param dividend The dividend (numerator)
+ * @param divisor The divisor (denominator)
+ * @return {0, 0}
+ */
+#define AFD_ZERO_DIVISOR_CHECK_DIVMOD(dividend, divisor) \
+  if ((divisor)==0U) { return { 0U, 0U }; }
+#endif
 
 namespace avr_fast_div_impl {
 
@@ -13,53 +61,308 @@ struct bit_width {
   static constexpr uint8_t value = sizeof(T) * CHAR_BIT;
 };
 
-// Process one step in the division algorithm for uint32_t/uint16_t
-static inline uint32_t divide_step(uint32_t dividend, const uint16_t &divisor) {
+#if !defined(AFD_BACKEND_AVR)
+// All backends but AFD_BACKEND_AVR replace the inline assembly below with these
+// portable models. They follow the assembly step for step (same shifts, carries &
+// comparisons), so AFD_C_MODEL can verify the algorithms exhaustively on a desktop
+// machine. The ARM backends override the narrow result kernels (see
+// afd_backend_arm.hpp) & route the rest to the division operator
+// (AFD_NATIVE_FALLBACK), so they run none of the models.
+
+#if defined(AFD_NATIVE_FALLBACK)
+// rem:quot by the division operator, where the remainder occupies the upper 
+// TDivisor bits. Requires (remQuot >> quot_bits) < divisor
+template <typename TRemQuot, typename TDivisor>
+static inline TRemQuot divide_rem_quot_native(TRemQuot remQuot, const TDivisor &divisor, uint8_t quotBits) {
+  const TRemQuot quot = (TRemQuot)(remQuot / divisor);
+  return (TRemQuot)((TRemQuot)((TRemQuot)(remQuot - (TRemQuot)(quot * divisor)) << quotBits) | quot);
+}
+#endif
+
+// Model of one restoring division step on a single rem:quot register, where the
+// remainder occupies the upper TDivisor bits
+template <typename TRemQuot, typename TDivisor>
+static inline TRemQuot divide_step_model(TRemQuot remQuot, const TDivisor &divisor) {
+  static constexpr uint8_t quot_bits = bit_width<TRemQuot>::value - bit_width<TDivisor>::value;
+  static constexpr TRemQuot quot_mask = (TRemQuot)(((TRemQuot)1U << quot_bits) - 1U);
+
+  // lsl/rol: the carry out is the top bit
+  const bool carry = (remQuot >> (bit_width<TRemQuot>::value-1U))!=0U;
+  remQuot = (TRemQuot)(remQuot << 1U);
+  const TDivisor rem = (TDivisor)(remQuot >> quot_bits);
+  if (carry || rem>=divisor) {
+    remQuot = (TRemQuot)(((TRemQuot)(TDivisor)(rem-divisor) << quot_bits) | (TRemQuot)(remQuot & quot_mask) | 1U);
+  }
+  return remQuot;
+}
+
+// Model of the byte skipping large divisor division: see divmod_large_divisor()
+template <typename T>
+static inline afd_divmod_t<T, T> divmod_large_divisor_model(T quot, const T &udivisor) {
+  static constexpr uint8_t byte_limit = bit_width<T>::value - bit_width<uint8_t>::value;
+  static constexpr uint8_t top_bit = bit_width<T>::value - 1U;
+
+  T rem = 0U;
+  uint8_t counter = bit_width<T>::value;
+  // Whole bytes, while the remainder stays below the divisor
+  while (((T)(rem >> byte_limit)==0U) && ((T)((T)(rem << 8U) | (T)(quot >> byte_limit)) < udivisor)) {
+    rem = (T)((T)(rem << 8U) | (T)(quot >> byte_limit));
+    quot = (T)(quot << 8U);
+    counter = (uint8_t)(counter - 8U);
+  }
+  // Bit by bit
+  do {
+    const bool carry = (rem >> top_bit)!=0U;
+    rem = (T)((T)(rem << 1U) | (T)(quot >> top_bit));
+    quot = (T)(quot << 1U);
+    if (carry || rem>=udivisor) {
+      rem = (T)(rem - udivisor);
+      quot = (T)(quot | 1U);
+    }
+  } while (--counter!=0U);
+  return { quot, rem };
+}
+#endif
+
+/**
+ * @brief The unsigned integer type that is Bytes wide
+ * 
+ * @tparam Bytes Width in bytes
+ */
+template <uint8_t Bytes>
+struct uint_bytes;
+
+template <>
+struct uint_bytes<1U> { typedef uint8_t type; };
+
+template <>
+struct uint_bytes<2U> { typedef uint16_t type; };
+
+#if defined(AFD_HAS_INT24)
+template <>
+struct uint_bytes<3U> { typedef __uint24 type; };
+#endif
+
+template <>
+struct uint_bytes<4U> { typedef uint32_t type; };
+
+template <>
+struct uint_bytes<8U> { typedef uint64_t type; };
+
+// The single step division kernels: one restoring division step on a rem:quot
+// register, where the remainder occupies the upper sizeof(TDivisor) bytes. There
+// is one divide_step() overload per rem:quot & divisor width, generated by
+// AFD_DIVIDE_STEP() below.
+//
+// The AVR assembly is generated from byte lists: %A0 to %D0 are the rem:quot bytes
+// & %A to %D of the divisor operand are the divisor bytes, least significant first.
+// So a new width is one line: the rem:quot shift & the remainder bytes.
+#if defined(AFD_BACKEND_AVR)
+// Shift rem:quot left by 1, through all its bytes. By width in bytes
+#define AFD_ASM_SHIFT_2 "    lsl  %A0      ; shift rem:quot\n\t" \
+                        "    rol  %B0      ;  left by 1\n\t"
+#define AFD_ASM_SHIFT_3 AFD_ASM_SHIFT_2 "    rol  %C0\n\t"
+#define AFD_ASM_SHIFT_4 AFD_ASM_SHIFT_3 "    rol  %D0\n\t"
+
+// Compare the remainder bytes (r0, r1...) with the bytes of divisor operand d
+#define AFD_ASM_COMPARE_1(d, r0)         "    cp   %" #r0 "0, %A" #d " ; is rem less than divisor?\n\t"
+#define AFD_ASM_COMPARE_2(d, r0, r1)     AFD_ASM_COMPARE_1(d, r0) "    cpc  %" #r1 "0, %B" #d "\n\t"
+#define AFD_ASM_COMPARE_3(d, r0, r1, r2) AFD_ASM_COMPARE_2(d, r0, r1) "    cpc  %" #r2 "0, %C" #d "\n\t"
+
+// Subtract the bytes of divisor operand d from the remainder bytes (r0, r1...)
+#define AFD_ASM_SUBTRACT_1(d, r0)         "    sub  %" #r0 "0, %A" #d " ; compute rem -= divisor\n\t"
+#define AFD_ASM_SUBTRACT_2(d, r0, r1)     AFD_ASM_SUBTRACT_1(d, r0) "    sbc  %" #r1 "0, %B" #d "\n\t"
+#define AFD_ASM_SUBTRACT_3(d, r0, r1, r2) AFD_ASM_SUBTRACT_2(d, r0, r1) "    sbc  %" #r2 "0, %C" #d "\n\t"
+
+// One division step
+#define AFD_ASM_DIVIDE_STEP(shift, compare, subtract) \
+        shift \
+        "    brcs 1f       ; if carry out, rem > divisor\n\t" \
+        compare \
+        "    brcs 2f       ; yes, when carry out\n\t" \
+        "1:\n\t" \
+        subtract \
+        "    ori  %A0, 1   ; record quotient bit as 1\n\t" \
+        "2:\n\t"
+
+// Define divide_step() for TRemQuot/TDivisor. width is the rem:quot width in bytes,
+// remBytes the remainder byte list: the upper sizeof(TDivisor) bytes
+#define AFD_DIVIDE_STEP(TRemQuot, TDivisor, width, remBytes, ...) \
+static inline TRemQuot divide_step(TRemQuot dividend, const TDivisor &divisor) { \
+    asm( \
+        AFD_ASM_DIVIDE_STEP(AFD_ASM_SHIFT_ ## width, \
+                            AFD_ASM_COMPARE_ ## remBytes(1, __VA_ARGS__), \
+                            AFD_ASM_SUBTRACT_ ## remBytes(1, __VA_ARGS__)) \
+      : "=d" (dividend) \
+      : "r" (divisor) , "0" (dividend) \
+      : \
+    ); \
+    return dividend; \
+}
+#else
+#define AFD_DIVIDE_STEP(TRemQuot, TDivisor, width, remBytes, ...) \
+static inline TRemQuot divide_step(TRemQuot dividend, const TDivisor &divisor) { \
+    return divide_step_model(dividend, divisor); \
+}
+#endif
+
+// uint16_t/uint8_t: 8-bit remainder, 8-bit quotient
+AFD_DIVIDE_STEP(uint16_t, uint8_t, 2, 1, B)
+// uint32_t/uint16_t: 16-bit remainder, 16-bit quotient
+AFD_DIVIDE_STEP(uint32_t, uint16_t, 4, 2, C, D)
+// uint32_t/uint8_t: 8-bit remainder, 24-bit quotient
+AFD_DIVIDE_STEP(uint32_t, uint8_t, 4, 1, D)
+#if defined(AFD_HAS_INT24)
+// __uint24/uint8_t: 8-bit remainder, 16-bit quotient
+AFD_DIVIDE_STEP(__uint24, uint8_t, 3, 1, C)
+// __uint24/uint16_t: 16-bit remainder, 8-bit quotient
+AFD_DIVIDE_STEP(__uint24, uint16_t, 3, 2, B, C)
+#endif
+
+#undef AFD_DIVIDE_STEP
+
+// Process one step in the division algorithm for uint64_t/uint32_t.
+// The quotient & remainder are passed as separate 32-bit operands, since
+// the operand modifiers only address 4 bytes (%A to %D)
+static inline void divide_step(uint32_t &quot, uint32_t &rem, const uint32_t &divisor) {
+#if !defined(AFD_BACKEND_AVR)
+    const bool carry = (rem >> 31U)!=0U;
+    rem = (rem << 1U) | (quot >> 31U);
+    quot = quot << 1U;
+    if (carry || rem>=divisor) {
+      rem = rem - divisor;
+      quot = quot | 1U;
+    }
+#else
     asm(
         "    lsl  %A0      ; shift\n\t"
         "    rol  %B0      ;  rem:quot\n\t"
         "    rol  %C0      ;   left\n\t"
-        "    rol  %D0      ;    by 1\n\t"
+        "    rol  %D0      ;    by\n\t"
+        "    rol  %A1      ;     1\n\t"
+        "    rol  %B1      ;\n\t"
+        "    rol  %C1      ;\n\t"
+        "    rol  %D1      ;\n\t"
         "    brcs 1f       ; if carry out, rem > divisor\n\t"
-        "    cp   %C0, %A1 ; is rem less\n\t"
-        "    cpc  %D0, %B1 ;  than divisor ?\n\t"
+        "    cp   %A1, %A2 ; is rem less\n\t"
+        "    cpc  %B1, %B2 ;  than\n\t"
+        "    cpc  %C1, %C2 ;   divisor\n\t"
+        "    cpc  %D1, %D2 ;    ?\n\t"
         "    brcs 2f       ; yes, when carry out\n\t"
         "1:\n\t"
-        "    sub  %C0, %A1 ; compute\n\t"
-        "    sbc  %D0, %B1 ;  rem -= divisor\n\t"
+        "    sub  %A1, %A2 ; compute\n\t"
+        "    sbc  %B1, %B2 ;  rem -=\n\t"
+        "    sbc  %C1, %C2 ;   divisor\n\t"
+        "    sbc  %D1, %D2 ;\n\t"
         "    ori  %A0, 1   ; record quotient bit as 1\n\t"
         "2:\n\t"
-      : "=d" (dividend) 
+      : "+d" (quot), "+r" (rem)
+      : "r" (divisor)
+      : 
+    ); 
+#endif
+}
+
+// Reinterpret a uint64_t as rem:quot halves without any shifting
+union rem_quot_u64_t {
+  uint64_t value;
+  struct {
+    uint32_t quot;
+    uint32_t rem;
+  } parts;
+};
+
+// Run the division algorithm over all bits of the divisor.
+// Lower half of the result contains the quotient, upper half contains the remainder
+template <typename TDividend, typename TDivisor>
+static inline TDividend divide_rem_quot(TDividend dividend, const TDivisor &divisor) {
+  static_assert(type_traits::is_unsigned<TDividend>::value, "TDividend must be unsigned");
+  static_assert(type_traits::is_unsigned<TDivisor>::value, "TDivisor must be unsigned");
+  static_assert(sizeof(TDividend)==sizeof(TDivisor)*2U, "TDivisor must half the size of TDividend");
+
+#if defined(AFD_NATIVE_FALLBACK)
+  return divide_rem_quot_native(dividend, divisor, bit_width<TDivisor>::value);
+#else
+  for (uint8_t index=0U; index<bit_width<TDivisor>::value; ++index) {
+    dividend = divide_step(dividend, divisor);
+  }
+  return dividend;
+#endif
+}
+
+#if defined(AFD_BACKEND_AVR)
+// The loop around a whole division in a single asm block. %1 is the loop counter. Either:
+//  * AFD_FAST_TEXT: fully unrolled. Fastest, but uses the most flash.
+//  * Otherwise: a tight dec/brne loop. Smallest.
+#if defined(AFD_FAST_TEXT)
+#define AFD_DIVIDE_LOOP_BEGIN(count) ".rept " #count "\n\t"
+#define AFD_DIVIDE_LOOP_END          ".endr\n\t"
+#else
+#define AFD_DIVIDE_LOOP_BEGIN(count) "    ldi  %1, " #count " ; loop counter\n\t" \
+                                     "3:\n\t"
+#define AFD_DIVIDE_LOOP_END          "    dec  %1       ; next\n\t" \
+                                     "    brne 3b       ;  bit\n\t"
+#endif
+#endif
+
+#if (defined(AFD_FAST_TEXT) || defined(AFD_SMALL_KERNELS)) && defined(AFD_BACKEND_AVR)
+
+// The divide_rem_quot() overloads below run the entire division in a single asm block, 
+// keeping rem:quot in registers throughout: unrolled with AFD_FAST_TEXT, a dec/brne
+// loop with AFD_SMALL_KERNELS. AFD_SMALL_TEXT alone keeps the C++ loop over
+// divide_step() below: it only controls inlining.
+
+static inline uint32_t divide_rem_quot(uint32_t dividend, const uint16_t &divisor) {
+    uint8_t counter;
+    asm(
+        AFD_DIVIDE_LOOP_BEGIN(16)
+        AFD_ASM_DIVIDE_STEP(AFD_ASM_SHIFT_4, AFD_ASM_COMPARE_2(2, C, D), AFD_ASM_SUBTRACT_2(2, C, D))
+        AFD_DIVIDE_LOOP_END
+      : "=d" (dividend), "=&d" (counter)
       : "d" (divisor) , "0" (dividend)
       : 
     ); 
+    (void)counter;
     return dividend;
 }
 
-// Process one step in the division algorithm for uint16_t/uint8_t
-static inline uint16_t divide_step(uint16_t dividend, const uint8_t &divisor) {
+static inline uint16_t divide_rem_quot(uint16_t dividend, const uint8_t &divisor) {
+    uint8_t counter;
     asm(
-        "    lsl  %A0      ; shift\n\t"
-        "    rol  %B0      ;  rem:quot\n\t"
-        "    brcs 1f       ; if carry out, rem > divisor\n\t"
-        "    cpc  %B0, %A1 ; is rem less than divisor?\n\t"
-        "    brcs 2f       ; yes, when carry out\n\t"
-        "1:\n\t"
-        "    sub  %B0, %A1 ; compute rem -= divisor\n\t"
-        "    ori  %A0, 1   ; record quotient bit as 1\n\t"
-        "2:\n\t"
-      : "=d" (dividend) 
+        AFD_DIVIDE_LOOP_BEGIN(8)
+        AFD_ASM_DIVIDE_STEP(AFD_ASM_SHIFT_2, AFD_ASM_COMPARE_1(2, B), AFD_ASM_SUBTRACT_1(2, B))
+        AFD_DIVIDE_LOOP_END
+      : "=d" (dividend), "=&d" (counter)
       : "d" (divisor) , "0" (dividend) 
       : 
     );
+    (void)counter;
     return dividend;  
 }
 
+#endif
+
+// As above, for uint64_t/uint32_t. The dividend is split into halves once,
+// rather than on every step.
+static inline uint64_t divide_rem_quot(uint64_t dividend, const uint32_t &divisor) {
+#if defined(AFD_NATIVE_FALLBACK)
+  return divide_rem_quot_native(dividend, divisor, bit_width<uint32_t>::value);
+#else
+  rem_quot_u64_t remQuot;
+  remQuot.value = dividend;
+  for (uint8_t index=0U; index<bit_width<uint32_t>::value; ++index) {
+    divide_step(remQuot.parts.quot, remQuot.parts.rem, divisor);
+  }
+  return remQuot.value;
+#endif
+}
+
 /**
  * @brief Optimised division: uint[n]_t/uint[n/2U]_t => uint[n/2U]_t quotient + uint[n/2U]_t remainder
  * 
  * Optimised division of unsigned number by unsigned smaller data type when it is known
  * that the quotient fits into the smaller data type. I.e.
+ *    uint64_t/uint32_t => uint32_t
  *    uint32_t/uint16_t => uint16_t
  *    uint16_t/uint8_t => uint8_t
  * 
@@ -74,43 +377,531 @@ static inline uint16_t divide_step(uint16_t dividend, const uint8_t &divisor) {
  */
 template <typename TDividend, typename TDivisor>
 static inline TDivisor divide(TDividend dividend, const TDivisor &divisor) {
+  return (TDivisor)divide_rem_quot(dividend, divisor);
+}
+
+/**
+ * @brief As divide(), but also returns the remainder
+ * 
+ * The remainder is a by-product of the division algorithm, so this costs
+ * nothing extra.
+ * 
+ * @note Bad things will likely happen if the quotient doesn't fit into the divisor.
+ * 
+ * @param dividend The dividend (numerator)
+ * @param divisor The divisor (denominator)
+ * @return Quotient & remainder
+ */
+template <typename TDividend, typename TDivisor>
+static inline afd_divmod_t<TDivisor, TDivisor> divmod(TDividend dividend, const TDivisor &divisor) {
+  TDividend remQuot = divide_rem_quot(dividend, divisor);
+  return { (TDivisor)remQuot, (TDivisor)(remQuot >> bit_width<TDivisor>::value) };
+}
+
+// rem:quot halves are the same width: use the divide_rem_quot() overloads (these
+// are the AFD_FAST_TEXT/AFD_SMALL_KERNELS & ARM backend kernels)
+template <uint8_t QuotBytes, typename TRemQuot, typename TDivisor>
+static inline TRemQuot divide_rem_quot_bytes(TRemQuot remQuot, const TDivisor &divisor, const type_traits::true_type&) {
+  return divide_rem_quot(remQuot, divisor);
+}
+// Otherwise, one divide_step() per quotient bit
+template <uint8_t QuotBytes, typename TRemQuot, typename TDivisor>
+static inline TRemQuot divide_rem_quot_bytes(TRemQuot remQuot, const TDivisor &divisor, const type_traits::false_type&) {
+#if defined(AFD_NATIVE_FALLBACK)
+  return divide_rem_quot_native(remQuot, divisor, QuotBytes*CHAR_BIT);
+#else
+  for (uint8_t index=0U; index<QuotBytes*CHAR_BIT; ++index) {
+    remQuot = divide_step(remQuot, divisor);
+  }
+  return remQuot;
+#endif
+}
+
+/**
+ * @brief Optimised division: uint[N]_t/uint[M]_t => QuotBytes wide quotient + uint[M]_t
+ * remainder, for any widths with a divide_step() kernel
+ * 
+ * If the quotient is known to fit into QuotBytes, the dividend fits into
+ * QuotBytes+sizeof(TDivisor) bytes. So the dividend's upper bytes are zero & are
+ * dropped, and the division takes only QuotBytes*8 steps. I.e.
+ *    uint32_t/uint8_t => uint8_t: the uint16_t/uint8_t kernel, 8 steps instead of 16
+ *    uint32_t/uint16_t => uint8_t: the __uint24/uint16_t kernel, 8 steps instead of 16
+ *    uint32_t/uint8_t => 24-bit: the uint32_t/uint8_t kernel, 24 steps
+ * 
+ * Lower QuotBytes bytes of the result contain the quotient, the upper bytes the remainder.
+ * 
+ * @note Bad things will likely happen if the quotient doesn't fit. I.e. requires 
+ * dividend < divisor << (QuotBytes*8)
+ * 
+ * @tparam QuotBytes Width of the quotient in bytes
+ * @param dividend The dividend (numerator)
+ * @param divisor The divisor (denominator)
+ * @return rem:quot
+ */
+template <uint8_t QuotBytes, typename TDividend, typename TDivisor>
+static inline typename uint_bytes<QuotBytes+sizeof(TDivisor)>::type divide_rem_quot_bytes(TDividend dividend, const TDivisor &divisor) {
+  using rem_quot_t = typename uint_bytes<QuotBytes+sizeof(TDivisor)>::type;
   static_assert(type_traits::is_unsigned<TDividend>::value, "TDividend must be unsigned");
   static_assert(type_traits::is_unsigned<TDivisor>::value, "TDivisor must be unsigned");
-  static_assert(sizeof(TDividend)==sizeof(TDivisor)*2U, "TDivisor must half the size of TDividend");
+  static_assert(sizeof(rem_quot_t)<=sizeof(TDividend), "The quotient & divisor can't be wider than TDividend");
 
-  for (uint8_t index=0U; index<bit_width<TDivisor>::value; ++index) {
-    dividend = divide_step(dividend, divisor);
+  return divide_rem_quot_bytes<QuotBytes>((rem_quot_t)dividend, divisor, 
+                                          type_traits::integral_constant<bool, QuotBytes==sizeof(TDivisor)>());
+}
+
+/**
+ * @brief As divide_rem_quot_bytes(), where the quotient is a TQuot
+ * 
+ * @note Bad things will likely happen if the quotient doesn't fit into TQuot.
+ * 
+ * @tparam TQuot The quotient type
+ * @param dividend The dividend (numerator)
+ * @param divisor The divisor (denominator)
+ * @return Quotient & remainder
+ */
+template <typename TQuot, typename TDividend, typename TDivisor>
+static inline afd_divmod_t<TQuot, TDivisor> divmod_narrow(TDividend dividend, const TDivisor &divisor) {
+  const auto remQuot = divide_rem_quot_bytes<sizeof(TQuot)>(dividend, divisor);
+  return { (TQuot)remQuot, (TDivisor)(remQuot >> bit_width<TQuot>::value) };
+}
+
+/**
+ * @brief As divmod_narrow(), without the remainder
+ */
+template <typename TQuot, typename TDividend, typename TDivisor>
+static inline TQuot divide_narrow(TDividend dividend, const TDivisor &divisor) {
+  return (TQuot)divide_rem_quot_bytes<sizeof(TQuot)>(dividend, divisor);
+}
+
+// Divide (rem << bits) by divisor, where rem<divisor. I.e. generate the next
+// "bits" quotient bits of a long division. Requires bits<=16
+static inline uint16_t divide_fraction(uint16_t rem, const uint16_t &divisor, uint8_t bits) {
+#if defined(AFD_NATIVE_FALLBACK)
+  return (uint16_t)(((uint32_t)rem << bits) / divisor);
+#else
+  // The lower half starts at zero: these are the bits shifted into the remainder
+  uint32_t remQuot = (uint32_t)rem << 16U;
+  for (uint8_t index=0U; index<bits; ++index) {
+    remQuot = divide_step(remQuot, divisor);
+  }
+  return (uint16_t)remQuot;
+#endif
+}
+
+// As above, for uint8_t. Requires bits<=8
+static inline uint8_t divide_fraction(uint8_t rem, const uint8_t &divisor, uint8_t bits) {
+#if defined(AFD_NATIVE_FALLBACK)
+  return (uint8_t)(((uint16_t)rem << bits) / divisor);
+#else
+  uint16_t remQuot = (uint16_t)((uint16_t)rem << 8U);
+  for (uint8_t index=0U; index<bits; ++index) {
+    remQuot = divide_step(remQuot, divisor);
+  }
+  return (uint8_t)remQuot;
+#endif
+}
+
+// As above, for uint32_t. Requires bits<=32
+static inline uint32_t divide_fraction(uint32_t rem, const uint32_t &divisor, uint8_t bits) {
+#if defined(AFD_NATIVE_FALLBACK)
+  return (uint32_t)(((uint64_t)rem << bits) / divisor);
+#else
+  uint32_t quot = 0U;
+  for (uint8_t index=0U; index<bits; ++index) {
+    divide_step(quot, rem, divisor);
   }
-  // Lower word contains the quotient, upper word contains the remainder
-  return (TDivisor)dividend;
+  return quot;
+#endif
+}
+
+// Full width product of a uint16_t & a uint16_t, using the hardware multiplier.
+// The compiler would call __umulhisi3 instead.
+static inline uint32_t multiply(uint16_t a, uint16_t b) {
+#if defined(__AVR_HAVE_MUL__)
+    uint32_t product;
+    uint8_t zero;
+    asm(
+        "    mul  %A2, %A3 ; low * low\n\t"
+        "    mov  %A0, __tmp_reg__\n\t"
+        "    mov  %B0, __zero_reg__\n\t"
+        "    mul  %B2, %B3 ; high * high\n\t"
+        "    mov  %C0, __tmp_reg__\n\t"
+        "    mov  %D0, __zero_reg__\n\t"
+        "    clr  %1\n\t"
+        "    mul  %A2, %B3 ; low * high\n\t"
+        "    add  %B0, __tmp_reg__\n\t"
+        "    adc  %C0, __zero_reg__\n\t"
+        "    adc  %D0, %1\n\t"
+        "    mul  %B2, %A3 ; high * low\n\t"
+        "    add  %B0, __tmp_reg__\n\t"
+        "    adc  %C0, __zero_reg__\n\t"
+        "    adc  %D0, %1\n\t"
+        "    clr  __zero_reg__\n\t"
+      : "=&r" (product), "=&r" (zero)
+      : "r" (a), "r" (b)
+      : 
+    );
+    (void)zero;
+    return product;
+#else
+    return (uint32_t)a * b;
+#endif
+}
+
+// As above, for uint16_t * uint8_t. The product is 24-bits
+static inline uint32_t multiply(uint16_t a, uint8_t b) {
+#if defined(__AVR_HAVE_MUL__)
+    uint32_t product;
+    asm(
+        "    mul  %A1, %2  ; low * b\n\t"
+        "    mov  %A0, __tmp_reg__\n\t"
+        "    mov  %B0, __zero_reg__\n\t"
+        "    mul  %B1, %2  ; high * b\n\t"
+        "    add  %B0, __tmp_reg__\n\t"
+        "    mov  %C0, __zero_reg__\n\t"
+        "    clr  __zero_reg__ ; (preserves carry)\n\t"
+        "    adc  %C0, __zero_reg__\n\t"
+        "    clr  %D0\n\t"
+      : "=&r" (product)
+      : "r" (a), "r" (b)
+      : 
+    );
+    return product;
+#else
+    return (uint32_t)a * b;
+#endif
+}
+
+#if defined(AFD_BACKEND_AVR)
+// The muldiv_rem_quot() division loop only runs if the quotient fits: skip to label
+// 4 (after the loop) if the product's upper half is the same as or higher than the divisor.
+// Unrolled, the loop is out of brsh's reach.
+#if defined(AFD_FAST_TEXT)
+#define AFD_ASM_SKIP_IF_NO_FIT "    brlo 5f       ; fits: divide\n\t" \
+                               "    rjmp 4f       ; no: leave the product\n\t" \
+                               "5:\n\t"
+#else
+#define AFD_ASM_SKIP_IF_NO_FIT "    brsh 4f       ; no fit: leave the product\n\t"
+#endif
+#endif
+
+/**
+ * @brief a*b/divisor in one pass: the fused form of divide_rem_quot(multiply(a, b), divisor)
+ * 
+ * On AVR, a single asm block multiplies straight into the rem:quot registers & runs 
+ * the division steps on them, so there are no moves between the multiply & the divide.
+ * 
+ * @return true if the quotient fits into 16-bits: remQuot is the rem:quot. Otherwise
+ * false & remQuot is the product. Either way, the test is the upper half: after a
+ * division the remainder is less than the divisor, while a product whose quotient
+ * won't fit has an upper half of at least the divisor.
+ */
+static inline bool muldiv_rem_quot(uint16_t a, uint16_t b, const uint16_t &divisor, uint32_t &remQuot) {
+#if defined(AFD_BACKEND_AVR) && defined(__AVR_HAVE_MUL__)
+    uint32_t value;
+    uint8_t counter;
+    asm(
+        "    mul  %A2, %A3 ; low * low\n\t"
+        "    mov  %A0, __tmp_reg__\n\t"
+        "    mov  %B0, __zero_reg__\n\t"
+        "    mul  %B2, %B3 ; high * high\n\t"
+        "    mov  %C0, __tmp_reg__\n\t"
+        "    mov  %D0, __zero_reg__\n\t"
+        "    clr  %1\n\t"
+        "    mul  %A2, %B3 ; low * high\n\t"
+        "    add  %B0, __tmp_reg__\n\t"
+        "    adc  %C0, __zero_reg__\n\t"
+        "    adc  %D0, %1\n\t"
+        "    mul  %B2, %A3 ; high * low\n\t"
+        "    add  %B0, __tmp_reg__\n\t"
+        "    adc  %C0, __zero_reg__\n\t"
+        "    adc  %D0, %1\n\t"
+        "    clr  __zero_reg__\n\t"
+        "    cp   %C0, %A4 ; does the quotient fit?\n\t"
+        "    cpc  %D0, %B4\n\t"
+        AFD_ASM_SKIP_IF_NO_FIT
+        AFD_DIVIDE_LOOP_BEGIN(16)
+        AFD_ASM_DIVIDE_STEP(AFD_ASM_SHIFT_4, AFD_ASM_COMPARE_2(4, C, D), AFD_ASM_SUBTRACT_2(4, C, D))
+        AFD_DIVIDE_LOOP_END
+        "4:\n\t"
+      : "=&d" (value), "=&d" (counter)
+      : "r" (a), "r" (b), "r" (divisor)
+      : 
+    );
+    (void)counter;
+    remQuot = value;
+#else
+    remQuot = multiply(a, b);
+    if ((uint16_t)(remQuot >> 16U) < divisor) {
+      remQuot = divide_rem_quot(remQuot, divisor);
+    }
+#endif
+    return (uint16_t)(remQuot >> 16U) < divisor;
 }
 
+/**
+ * @brief As above, for uint16_t * uint8_t / uint8_t: a 24-bit rem:quot with an
+ * 8-bit remainder (byte 2). The upper byte of remQuot is zero.
+ */
+static inline bool muldiv_rem_quot(uint16_t a, uint8_t b, const uint8_t &divisor, uint32_t &remQuot) {
+#if defined(AFD_BACKEND_AVR) && defined(__AVR_HAVE_MUL__)
+    uint32_t value;
+    uint8_t counter;
+    asm(
+        "    mul  %A2, %3  ; low * b\n\t"
+        "    mov  %A0, __tmp_reg__\n\t"
+        "    mov  %B0, __zero_reg__\n\t"
+        "    mul  %B2, %3  ; high * b\n\t"
+        "    add  %B0, __tmp_reg__\n\t"
+        "    mov  %C0, __zero_reg__\n\t"
+        "    clr  __zero_reg__ ; (preserves carry)\n\t"
+        "    adc  %C0, __zero_reg__\n\t"
+        "    clr  %D0\n\t"
+        "    cp   %C0, %4  ; does the quotient fit?\n\t"
+        AFD_ASM_SKIP_IF_NO_FIT
+        AFD_DIVIDE_LOOP_BEGIN(16)
+        AFD_ASM_DIVIDE_STEP(AFD_ASM_SHIFT_3, AFD_ASM_COMPARE_1(4, C), AFD_ASM_SUBTRACT_1(4, C))
+        AFD_DIVIDE_LOOP_END
+        "4:\n\t"
+      : "=&d" (value), "=&d" (counter)
+      : "r" (a), "r" (b), "r" (divisor)
+      : 
+    );
+    (void)counter;
+    remQuot = value;
+#else
+    remQuot = multiply(a, b);
+    if ((uint8_t)(remQuot >> 16U) < divisor) {
+#if defined(AFD_HAS_INT24)
+      remQuot = divide_rem_quot_bytes<2U>(remQuot, divisor);
+#else
+      // A 16-bit remainder, but less than the divisor: byte 2 holds it all
+      remQuot = divide_rem_quot(remQuot, (uint16_t)divisor);
+#endif
+    }
+#endif
+    return (uint8_t)(remQuot >> 16U) < divisor;
+}
+
+#if defined(AFD_BACKEND_AVR)
+#undef AFD_ASM_SKIP_IF_NO_FIT
+#undef AFD_DIVIDE_LOOP_BEGIN
+#undef AFD_DIVIDE_LOOP_END
+#undef AFD_ASM_SHIFT_2
+#undef AFD_ASM_SHIFT_3
+#undef AFD_ASM_SHIFT_4
+#undef AFD_ASM_COMPARE_1
+#undef AFD_ASM_COMPARE_2
+#undef AFD_ASM_COMPARE_3
+#undef AFD_ASM_SUBTRACT_1
+#undef AFD_ASM_SUBTRACT_2
+#undef AFD_ASM_SUBTRACT_3
+#undef AFD_ASM_DIVIDE_STEP
+#endif
+
+#if defined(AFD_RECIPROCAL_TABLE)
+
+// AFD_RECIPROCAL_TABLE replaces the uint16_t/uint8_t & uint32_t/uint8_t division
+// loops with a multiply by a reciprocal from a lookup table, plus one correction
+// step. The table costs 512 bytes of flash. Needs the hardware multiplier to pay off.
+//
+// Entry d is floor((2^16-1)/d). For any 16-bit n, (n*entry)>>16 is then either
+// n/d or n/d-1 (the table entry slightly underestimates 2^16/d, by less than
+// 1 part in 2^16/d). So one correction step suffices: test_reciprocal_table.cpp
+// checks that for every entry & 16-bit dividend.
+static const uint16_t reciprocal_table[256] AFD_PROGMEM = {
+  0x0000, 0xFFFF, 0x7FFF, 0x5555, 0x3FFF, 0x3333, 0x2AAA, 0x2492,
+  0x1FFF, 0x1C71, 0x1999, 0x1745, 0x1555, 0x13B1, 0x1249, 0x1111,
+  0x0FFF, 0x0F0F, 0x0E38, 0x0D79, 0x0CCC, 0x0C30, 0x0BA2, 0x0B21,
+  0x0AAA, 0x0A3D, 0x09D8, 0x097B, 0x0924, 0x08D3, 0x0888, 0x0842,
+  0x07FF, 0x07C1, 0x0787, 0x0750, 0x071C, 0x06EB, 0x06BC, 0x0690,
+  0x0666, 0x063E, 0x0618, 0x05F4, 0x05D1, 0x05B0, 0x0590, 0x0572,
+  0x0555, 0x0539, 0x051E, 0x0505, 0x04EC, 0x04D4, 0x04BD, 0x04A7,
+  0x0492, 0x047D, 0x0469, 0x0456, 0x0444, 0x0432, 0x0421, 0x0410,
+  0x03FF, 0x03F0, 0x03E0, 0x03D2, 0x03C3, 0x03B5, 0x03A8, 0x039B,
+  0x038E, 0x0381, 0x0375, 0x0369, 0x035E, 0x0353, 0x0348, 0x033D,
+  0x0333, 0x0329, 0x031F, 0x0315, 0x030C, 0x0303, 0x02FA, 0x02F1,
+  0x02E8, 0x02E0, 0x02D8, 0x02D0, 0x02C8, 0x02C0, 0x02B9, 0x02B1,
+  0x02AA, 0x02A3, 0x029C, 0x0295, 0x028F, 0x0288, 0x0282, 0x027C,
+  0x0276, 0x0270, 0x026A, 0x0264, 0x025E, 0x0259, 0x0253, 0x024E,
+  0x0249, 0x0243, 0x023E, 0x0239, 0x0234, 0x0230, 0x022B, 0x0226,
+  0x0222, 0x021D, 0x0219, 0x0214, 0x0210, 0x020C, 0x0208, 0x0204,
+  0x01FF, 0x01FC, 0x01F8, 0x01F4, 0x01F0, 0x01EC, 0x01E9, 0x01E5,
+  0x01E1, 0x01DE, 0x01DA, 0x01D7, 0x01D4, 0x01D0, 0x01CD, 0x01CA,
+  0x01C7, 0x01C3, 0x01C0, 0x01BD, 0x01BA, 0x01B7, 0x01B4, 0x01B2,
+  0x01AF, 0x01AC, 0x01A9, 0x01A6, 0x01A4, 0x01A1, 0x019E, 0x019C,
+  0x0199, 0x0197, 0x0194, 0x0192, 0x018F, 0x018D, 0x018A, 0x0188,
+  0x0186, 0x0183, 0x0181, 0x017F, 0x017D, 0x017A, 0x0178, 0x0176,
+  0x0174, 0x0172, 0x0170, 0x016E, 0x016C, 0x016A, 0x0168, 0x0166,
+  0x0164, 0x0162, 0x0160, 0x015E, 0x015C, 0x015A, 0x0158, 0x0157,
+  0x0155, 0x0153, 0x0151, 0x0150, 0x014E, 0x014C, 0x014A, 0x0149,
+  0x0147, 0x0146, 0x0144, 0x0142, 0x0141, 0x013F, 0x013E, 0x013C,
+  0x013B, 0x0139, 0x0138, 0x0136, 0x0135, 0x0133, 0x0132, 0x0130,
+  0x012F, 0x012E, 0x012C, 0x012B, 0x0129, 0x0128, 0x0127, 0x0125,
+  0x0124, 0x0123, 0x0121, 0x0120, 0x011F, 0x011E, 0x011C, 0x011B,
+  0x011A, 0x0119, 0x0118, 0x0116, 0x0115, 0x0114, 0x0113, 0x0112,
+  0x0111, 0x010F, 0x010E, 0x010D, 0x010C, 0x010B, 0x010A, 0x0109,
+  0x0108, 0x0107, 0x0106, 0x0105, 0x0104, 0x0103, 0x0102, 0x0101,
+};
+
+static inline uint16_t read_reciprocal(uint8_t divisor) {
+#if defined(__AVR__)
+  return pgm_read_word(&reciprocal_table[divisor]);
+#else
+  return reciprocal_table[divisor];
+#endif
+}
+
+// uint16_t/uint8_t => uint16_t quotient + uint8_t remainder, for any dividend.
+// Requires divisor!=0
+static inline afd_divmod_t<uint16_t, uint8_t> divmod_reciprocal(uint16_t dividend, uint8_t divisor, uint16_t reciprocal) {
+  uint16_t quot = (uint16_t)(multiply(dividend, reciprocal) >> 16U);
+  // The product can't exceed the dividend, so 16-bits is enough
+  uint16_t rem = (uint16_t)(dividend - (uint16_t)multiply(quot, divisor));
+  if (rem>=divisor) {
+    ++quot;
+    rem = (uint16_t)(rem - divisor);
+  }
+  return { quot, (uint8_t)rem };
+}
+
+static inline uint16_t divide_reciprocal(uint16_t dividend, uint8_t divisor) {
+  return divmod_reciprocal(dividend, divisor, read_reciprocal(divisor)).quot;
+}
+
+// Long division: the upper word, then the remainder:next byte twice. Since
+// each remainder is less than divisor, those dividends fit into 16-bits.
+static inline uint32_t divide_reciprocal(uint32_t dividend, uint8_t divisor) {
+  const uint16_t reciprocal = read_reciprocal(divisor);
+  const afd_divmod_t<uint16_t, uint8_t> upper = divmod_reciprocal((uint16_t)(dividend >> 16U), divisor, reciprocal);
+  const afd_divmod_t<uint16_t, uint8_t> middle = divmod_reciprocal((uint16_t)(((uint16_t)upper.rem << 8U) | (uint8_t)(dividend >> 8U)), divisor, reciprocal);
+  const afd_divmod_t<uint16_t, uint8_t> lower = divmod_reciprocal((uint16_t)(((uint16_t)middle.rem << 8U) | (uint8_t)dividend), divisor, reciprocal);
+  return ((uint32_t)upper.quot << 16U) | ((uint32_t)middle.quot << 8U) | lower.quot;
+}
+
+#endif
+
+#if defined(AFD_HAS_INT24)
+
+/**
+ * @brief Optimised division: __uint24/uint8_t => uint16_t quotient + uint8_t remainder
+ * 
+ * @note Bad things will likely happen if the quotient doesn't fit into 16-bits.
+ */
+static inline afd_divmod_t<uint16_t, uint8_t> divmod(__uint24 dividend, const uint8_t &divisor) {
+  return divmod_narrow<uint16_t>(dividend, divisor);
+}
+static inline uint16_t divide(__uint24 dividend, const uint8_t &divisor) {
+  return divide_narrow<uint16_t>(dividend, divisor);
+}
+
+/**
+ * @brief Optimised division: __uint24/uint16_t => uint8_t quotient + uint16_t remainder
+ * 
+ * @note Bad things will likely happen if the quotient doesn't fit into 8-bits.
+ */
+static inline afd_divmod_t<uint8_t, uint16_t> divmod(__uint24 dividend, const uint16_t &divisor) {
+  return divmod_narrow<uint8_t>(dividend, divisor);
+}
+static inline uint8_t divide(__uint24 dividend, const uint16_t &divisor) {
+  return divide_narrow<uint8_t>(dividend, divisor);
+}
+
+#endif
+
+#if defined(AFD_POW2_DIVISOR)
+// True if value has a single bit set. Requires value!=0 (zero passes too)
+template <typename T>
+static inline bool is_pow2(T value) {
+  return (T)(value & (T)(value-1U))==0U;
+}
+
+// dividend/divisor, where divisor is a power of two. Whole bytes first
+// (register moves), then bit by bit: at most 7 single bit shifts.
+template <typename TDividend, typename TDivisor>
+static inline TDividend divide_pow2(TDividend dividend, TDivisor divisor) {
+  while (divisor>(TDivisor)UINT8_MAX) {
+    dividend = (TDividend)(dividend >> 8U);
+    divisor = (TDivisor)(divisor >> 8U);
+  }
+  uint8_t divisorByte = (uint8_t)divisor;
+  while (divisorByte>1U) {
+    dividend = (TDividend)(dividend >> 1U);
+    divisorByte = (uint8_t)(divisorByte >> 1U);
+  }
+  return dividend;
+}
+#endif
+
 template <typename T>
 static inline bool is_aligned(const T &reference, const T &dependent) {
   static constexpr T max_bit = (T)1U << (bit_width<T>::value-1U);
   return ((T)(dependent<<(T)1U) > reference) || (dependent & max_bit);
 }
 
+#if defined(AFD_ALIGN_CLZ) || defined(AFD_NEWTON_RAPHSON)
+// Count of leading zero bits. Undefined for zero.
+static inline uint8_t count_leading_zeros(uint16_t value) {
+  return (uint8_t)(__builtin_clz(value) - (bit_width<unsigned int>::value - bit_width<uint16_t>::value));
+}
+static inline uint8_t count_leading_zeros(uint32_t value) {
+  return (uint8_t)(__builtin_clzl(value) - (bit_width<unsigned long>::value - bit_width<uint32_t>::value));
+}
+static inline uint8_t count_leading_zeros(uint64_t value) {
+  return (uint8_t)(__builtin_clzll(value) - (bit_width<unsigned long long>::value - bit_width<uint64_t>::value));
+}
+#if defined(AFD_HAS_INT24)
+static inline uint8_t count_leading_zeros(__uint24 value) {
+  return (uint8_t)(count_leading_zeros((uint32_t)value) - (bit_width<uint32_t>::value - bit_width<__uint24>::value));
+}
+#endif
+#endif
+
 /**
  * @brief Left aligns the highest set bit of the dependent with the
  * highest set bit of the reference
  *
+ * By default this shifts by whole bytes first (cheap register moves), then
+ * bit by bit. Define AFD_ALIGN_CLZ to align in a single shift computed from
+ * the leading zero counts instead. On AVR, only the u24 & u64 large divisor
+ * paths get here: u16/u16 & u32/u32 have their own asm kernels.
+ * 
  * *Note* modifies parameter "dependent"
  *  
  * @param reference 
- * @param dependent 
+ * @param dependent Must be non-zero and <= reference
  * @return T A flag with a single bit set at the aligned bit 
  */
 template <typename T>
 static inline T align(const T &reference, T &dependent) {
+#if defined(AFD_ALIGN_CLZ)
+  uint8_t shift = (uint8_t)(count_leading_zeros(dependent)-count_leading_zeros(reference));
+  dependent = (T)(dependent<<shift);
+  if (dependent>reference) {
+    --shift;
+    dependent = (T)(dependent>>1U);
+  }
+  return (T)((T)1U<<shift);
+#else
+  static constexpr uint8_t coarse_shift = bit_width<uint8_t>::value;
+  static constexpr uint8_t coarse_limit = bit_width<T>::value - coarse_shift;
 
   T bit = 1;
+  // Coarse: whole bytes, while the upper byte is clear and the shifted value
+  // won't exceed the reference
+  while (((T)(dependent >> coarse_limit) == 0U) && ((T)(dependent << coarse_shift) <= reference))
+  {
+    dependent = (T)(dependent<<coarse_shift);
+    bit = (T)(bit<<coarse_shift);
+  }
+  // Fine: bit by bit
   while (!is_aligned(reference, dependent))
   {
     dependent = (T)(dependent<<1U);
     bit = (T)(bit<<1U);
   }
   return bit;
+#endif
 }
 
 template <typename T>
@@ -121,32 +912,26 @@ static constexpr inline T get_large_divisor_threshhold(void) {
 }
 
 /**
- * @brief A division function, applicable when the divisor is large
- * 
- * This function will work for all combinations of dividend & divisor, but only
- * apply it when the divisor is large. I.e. >sqrt(max(dividend)).
+ * @brief A division function, applicable when the divisor is large. Returns
+ * both quotient and remainder.
  * 
- * In this situation, on aggregate it's quicker to align the dividend with the divisor
- * and then divide rather than call the standard divide operator.
+ * See divide_large_divisor()
  * 
  * @tparam T 
  * @param udividend 
  * @param udivisor 
- * @return T 
+ * @return Quotient & remainder
  */
 template <typename T>
-static inline T divide_large_divisor(T udividend, T udivisor) {
+static inline afd_divmod_t<T, T> divmod_large_divisor(T udividend, T udivisor) {
   static_assert(type_traits::is_unsigned<T>::value, "T must be unsigned");
 
-#if defined(UNIT_TEST)
-  if (udivisor<=get_large_divisor_threshhold<T>()) { 
-    return 0;
-  }
-#endif
-
   if (udividend<udivisor) {
-    return 0;
+    return { 0U, udividend };
   }
+#if defined(AFD_NATIVE_FALLBACK)
+  return { (T)(udividend / udivisor), (T)(udividend % udivisor) };
+#else
   T bit = align(udividend, udivisor);
 
   // align() guarentees that udivisor<udividend
@@ -165,7 +950,491 @@ static inline T divide_large_divisor(T udividend, T udivisor) {
     bit = (T)(bit>>1U);
     udivisor = (T)(udivisor>>1U);
   }
-  return res;
+  // Whatever is left over is the remainder
+  return { res, udividend };
+#endif
 }
 
+#if defined(AFD_NEWTON_RAPHSON)
+
+// AFD_NEWTON_RAPHSON replaces the uint16_t/uint16_t & uint32_t/uint32_t large divisor
+// division loops with multiplication by the divisor's reciprocal.
+//
+// The divisor is normalized (shifted left until the top bit is set) & split into 2
+// digits: bytes for uint16_t, words for uint32_t. Since the divisor is large, the
+// quotient is a single digit, so the division is 3 digits (the shifted dividend)
+// by 2 digits. Given the reciprocal, that takes 3 digit multiplies plus a correction.
+// See Moller & Granlund, "Improved division by invariant integers" (algorithms 5 & 6).
+
+// floor((2^16-1)/d)-2^8 for d in [128, 255]. The exact reciprocal of a normalized
+// byte, and the seed for the reciprocal of a normalized word. Costs 128 bytes of flash.
+static const uint8_t reciprocal_seed_table[128] AFD_PROGMEM = {
+  0xFF, 0xFC, 0xF8, 0xF4, 0xF0, 0xEC, 0xE9, 0xE5, 0xE1, 0xDE, 0xDA, 0xD7, 0xD4, 0xD0, 0xCD, 0xCA,
+  0xC7, 0xC3, 0xC0, 0xBD, 0xBA, 0xB7, 0xB4, 0xB2, 0xAF, 0xAC, 0xA9, 0xA6, 0xA4, 0xA1, 0x9E, 0x9C,
+  0x99, 0x97, 0x94, 0x92, 0x8F, 0x8D, 0x8A, 0x88, 0x86, 0x83, 0x81, 0x7F, 0x7D, 0x7A, 0x78, 0x76,
+  0x74, 0x72, 0x70, 0x6E, 0x6C, 0x6A, 0x68, 0x66, 0x64, 0x62, 0x60, 0x5E, 0x5C, 0x5A, 0x58, 0x57,
+  0x55, 0x53, 0x51, 0x50, 0x4E, 0x4C, 0x4A, 0x49, 0x47, 0x46, 0x44, 0x42, 0x41, 0x3F, 0x3E, 0x3C,
+  0x3B, 0x39, 0x38, 0x36, 0x35, 0x33, 0x32, 0x30, 0x2F, 0x2E, 0x2C, 0x2B, 0x29, 0x28, 0x27, 0x25,
+  0x24, 0x23, 0x21, 0x20, 0x1F, 0x1E, 0x1C, 0x1B, 0x1A, 0x19, 0x18, 0x16, 0x15, 0x14, 0x13, 0x12,
+  0x11, 0x0F, 0x0E, 0x0D, 0x0C, 0x0B, 0x0A, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+};
+
+static inline uint8_t read_reciprocal_seed(uint8_t normalized) {
+#if defined(__AVR__)
+  return pgm_read_byte(&reciprocal_seed_table[normalized-128U]);
+#else
+  return reciprocal_seed_table[normalized-128U];
+#endif
+}
+
+// Maps the type being divided to the digit type
+template <typename T>
+struct reciprocal_traits;
+
+template <>
+struct reciprocal_traits<uint16_t> { typedef uint8_t digit_t; };
+
+template <>
+struct reciprocal_traits<uint32_t> { typedef uint16_t digit_t; };
+
+// Full width product of 2 bytes: a single mul instruction
+static inline uint16_t multiply(uint8_t a, uint8_t b) {
+  return (uint16_t)((uint16_t)a * b);
+}
+
+// The reciprocal of a normalized digit: floor((beta^2-1)/d1)-beta, where beta=2^8
+static inline uint8_t reciprocal_digit(uint8_t d1) {
+  return read_reciprocal_seed(d1);
+}
+
+// As above, where beta=2^16. The seed table gives ~8 bits, then 2 Newton-Raphson 
+// iterations (v += v*(1-(d1*v))) refine that to within 1 of the exact reciprocal.
+//
+// Every product is a 16x16=>32 multiply(): the errors are signed, so each
+// correction multiplies the error's magnitude & then adds or subtracts.
+static inline uint16_t reciprocal_digit(uint16_t d1) {
+  // 2^32-(d1<<16): the iterations compute the error 2^32-(2^16+v)*d1 from this
+  const uint32_t upper = (uint32_t)(uint16_t)(0U-d1) << 16U;
+
+  // v1 = v0 + floor((2^16+v0)*e0/2^16), where e0 is the error's upper word
+  const uint16_t v0 = (uint16_t)((uint16_t)read_reciprocal_seed((uint8_t)(d1 >> 8U)) << 8U);
+  const int16_t e0 = (int16_t)((int32_t)(upper - multiply(v0, d1)) >> 16U);
+  uint16_t v1;
+  if (e0>=0) {
+    v1 = (uint16_t)(v0 + (uint16_t)e0 + (uint16_t)(multiply((uint16_t)e0, v0) >> 16U));
+  } else {
+    const uint32_t product = multiply((uint16_t)(0U-(uint16_t)e0), v0);
+    // Rounds away from zero: the floor of a negative value
+    v1 = (uint16_t)(v0 - (uint16_t)(0U-(uint16_t)e0) - (uint16_t)(product >> 16U) - ((uint16_t)product!=0U ? 1U : 0U));
+  }
+
+  // v2 = v1 + floor((2^16+v1)*e1/2^32). |e1| < 2^20, so split it into words:
+  // |e1|*(2^16+v1) = (|e1|<<16) + ((|e1|>>16)*v1<<16) + (uint16_t)|e1|*v1
+  const int32_t e1 = (int32_t)(upper - multiply(v1, d1));
+  const uint32_t e1Magnitude = e1<0 ? (uint32_t)0U-(uint32_t)e1 : (uint32_t)e1;
+  const uint16_t step = (uint16_t)((e1Magnitude
+                                   + multiply((uint16_t)(e1Magnitude >> 16U), v1)
+                                   + (multiply((uint16_t)e1Magnitude, v1) >> 16U)) >> 16U);
+  uint16_t v2 = e1<0 ? (uint16_t)(v1 - step - 1U) : (uint16_t)(v1 + step);
+
+  // Correct: v2 is either exact or 1 too small
+  if ((uint32_t)~(((uint32_t)d1 << 16U) + multiply(v2, d1)) >= d1) {
+    ++v2;
+  }
+  return v2;
+}
+
+// The reciprocal of a normalized 2 digit divisor: floor((beta^3-1)/(d1:d0))-beta.
+// Algorithm 6: adjust the reciprocal of d1 for d0
+template <typename TDigit>
+static inline TDigit reciprocal_3by2(TDigit d1, TDigit d0) {
+  using double_t = decltype(multiply(d1, d0));
+  static constexpr uint8_t digit_bits = bit_width<TDigit>::value;
+
+  TDigit v = reciprocal_digit(d1);
+  TDigit p = (TDigit)((TDigit)multiply(d1, v) + d0);
+  if (p<d0) {
+    --v;
+    if (p>=d1) {
+      --v;
+      p = (TDigit)(p - d1);
+    }
+    p = (TDigit)(p - d1);
+  }
+  const double_t t = multiply(v, d0);
+  const TDigit t1 = (TDigit)(t >> digit_bits);
+  p = (TDigit)(p + t1);
+  if (p<t1) {
+    --v;
+    if ((double_t)(((double_t)p << digit_bits) | (TDigit)t) >= (double_t)(((double_t)d1 << digit_bits) | d0)) {
+      --v;
+    }
+  }
+  return v;
+}
+
+// Divide u2:u10 (3 digits) by the normalized divisor (2 digits), where u2:u1 < divisor.
+// Algorithm 5: the quotient estimate from the reciprocal is at most 1 digit out,
+// so needs one (unpredictable) correction, and very rarely a second.
+template <typename TDigit, typename TDouble>
+static inline afd_divmod_t<TDigit, TDouble> divide_3by2(TDigit u2, TDouble u10, TDouble divisor, TDigit v) {
+  static constexpr uint8_t digit_bits = bit_width<TDigit>::value;
+  const TDigit d1 = (TDigit)(divisor >> digit_bits);
+  const TDigit d0 = (TDigit)divisor;
+  const TDigit u1 = (TDigit)(u10 >> digit_bits);
+
+  const TDouble q = (TDouble)(multiply(v, u2) + (TDouble)(((TDouble)u2 << digit_bits) | u1));
+  TDigit q1 = (TDigit)(q >> digit_bits);
+  const TDigit q0 = (TDigit)q;
+  const TDigit r1 = (TDigit)(u1 - (TDigit)multiply(q1, d1));
+  TDouble rem = (TDouble)((TDouble)(((TDouble)r1 << digit_bits) | (TDigit)u10) - divisor);
+  rem = (TDouble)(rem - multiply(d0, q1));
+  ++q1;
+  if ((TDigit)(rem >> digit_bits) >= q0) {
+    --q1;
+    rem = (TDouble)(rem + divisor);
+  }
+  if (rem>=divisor) {
+    ++q1;
+    rem = (TDouble)(rem - divisor);
+  }
+  return { q1, rem };
+}
+
+// Division by a large divisor (upper half bits set), using the reciprocal
+template <typename T>
+static inline afd_divmod_t<T, T> divmod_reciprocal_3by2(T udividend, T udivisor) {
+  using digit_t = typename reciprocal_traits<T>::digit_t;
+  static constexpr uint8_t digit_bits = bit_width<digit_t>::value;
+
+  // Normalize. The divisor is large, so shift<digit_bits
+  const uint8_t shift = count_leading_zeros(udivisor);
+  const T divisor = (T)(udivisor << shift);
+  // The dividend, shifted by the same amount, as 3 digits: u2:u10. Since
+  // shift<digit_bits, u2 comes from the upper digit alone: a digit wide shift
+  const digit_t u2 = shift==0U ? (digit_t)0U : (digit_t)((digit_t)(udividend >> digit_bits) >> (digit_bits - shift));
+  const T u10 = (T)(udividend << shift);
+
+  const digit_t v = reciprocal_3by2((digit_t)(divisor >> digit_bits), (digit_t)divisor);
+  const afd_divmod_t<digit_t, T> result = divide_3by2(u2, u10, divisor, v);
+  return { (T)result.quot, (T)(result.rem >> shift) };
+}
+
+#endif
+
+// The divmod_large_divisor() overloads below are hand written versions of the template
+// above for the common types. Instead of aligning the divisor one bit at a time, the
+// dividend is shifted into the remainder in whole bytes while the remainder stays
+// below the divisor (I.e. those quotient bits are all zero). The restoring division
+// loop then only runs over the remaining bits.
+
+static inline afd_divmod_t<uint16_t, uint16_t> divmod_large_divisor(uint16_t udividend, uint16_t udivisor) {
+  if (udividend<udivisor) {
+    return { 0U, udividend };
+  }
+#if defined(AFD_BACKEND_RP2040)
+  const afd_divmod_t<uint32_t, uint32_t> result = divmod_sio(udividend, udivisor);
+  return { (uint16_t)result.quot, (uint16_t)result.rem };
+#elif defined(AFD_NATIVE_FALLBACK)
+  return { (uint16_t)(udividend / udivisor), (uint16_t)(udividend % udivisor) };
+#elif defined(AFD_NEWTON_RAPHSON)
+  return divmod_reciprocal_3by2(udividend, udivisor);
+#elif !defined(AFD_BACKEND_AVR)
+  return divmod_large_divisor_model(udividend, udivisor);
+#else
+  uint16_t rem = 0U;
+  uint8_t counter;
+  asm(
+      "    ldi  %2, 16   ; bit count\n\t"
+      "4:\n\t"
+      "    tst  %B1      ; can rem be shifted 1 byte?\n\t"
+      "    brne 5f       ; no, when upper byte is set\n\t"
+      "    cp   %B0, %A3 ; is (rem<<8)|(quot>>8)\n\t"
+      "    cpc  %A1, %B3 ;  less than divisor?\n\t"
+      "    brcc 5f       ; no, when carry clear\n\t"
+      "    mov  %B1, %A1 ; shift\n\t"
+      "    mov  %A1, %B0 ;  rem:quot\n\t"
+      "    mov  %B0, %A0 ;   left\n\t"
+      "    clr  %A0      ;    by 8\n\t"
+      "    subi %2, 8    ; 8 fewer bits to process\n\t"
+      "    rjmp 4b       ; try the next byte\n\t"
+      "5:\n\t"
+      "3:\n\t"
+      "    lsl  %A0      ; shift\n\t"
+      "    rol  %B0      ;  rem:quot\n\t"
+      "    rol  %A1      ;   left\n\t"
+      "    rol  %B1      ;    by 1\n\t"
+      "    brcs 1f       ; if carry out, rem > divisor\n\t"
+      "    cp   %A1, %A3 ; is rem less\n\t"
+      "    cpc  %B1, %B3 ;  than divisor ?\n\t"
+      "    brcs 2f       ; yes, when carry out\n\t"
+      "1:\n\t"
+      "    sub  %A1, %A3 ; compute\n\t"
+      "    sbc  %B1, %B3 ;  rem -= divisor\n\t"
+      "    ori  %A0, 1   ; record quotient bit as 1\n\t"
+      "2:\n\t"
+      "    dec  %2       ; next\n\t"
+      "    brne 3b       ;  bit\n\t"
+    : "+d" (udividend), "+r" (rem), "=&d" (counter)
+    : "r" (udivisor)
+    : 
+  );
+  (void)counter;
+  return { udividend, rem };
+#endif
+}
+
+// As above, for uint32_t/uint32_t
+static inline afd_divmod_t<uint32_t, uint32_t> divmod_large_divisor(uint32_t udividend, uint32_t udivisor) {
+  if (udividend<udivisor) {
+    return { 0U, udividend };
+  }
+#if defined(AFD_BACKEND_RP2040)
+  const afd_divmod_t<uint32_t, uint32_t> result = divmod_sio(udividend, udivisor);
+  return { (uint32_t)result.quot, (uint32_t)result.rem };
+#elif defined(AFD_NATIVE_FALLBACK)
+  return { (uint32_t)(udividend / udivisor), (uint32_t)(udividend % udivisor) };
+#elif defined(AFD_NEWTON_RAPHSON)
+  return divmod_reciprocal_3by2(udividend, udivisor);
+#elif !defined(AFD_BACKEND_AVR)
+  return divmod_large_divisor_model(udividend, udivisor);
+#else
+  uint32_t rem = 0U;
+  uint8_t counter;
+  asm(
+      "    ldi  %2, 32   ; bit count\n\t"
+      "4:\n\t"
+      "    tst  %D1      ; can rem be shifted 1 byte?\n\t"
+      "    brne 5f       ; no, when upper byte is set\n\t"
+      "    cp   %D0, %A3 ; is (rem<<8)|(quot>>24)\n\t"
+      "    cpc  %A1, %B3 ;  less\n\t"
+      "    cpc  %B1, %C3 ;   than\n\t"
+      "    cpc  %C1, %D3 ;    divisor?\n\t"
+      "    brcc 5f       ; no, when carry clear\n\t"
+      "    mov  %D1, %C1 ; shift\n\t"
+      "    mov  %C1, %B1 ;  rem:quot\n\t"
+      "    mov  %B1, %A1 ;   left\n\t"
+      "    mov  %A1, %D0 ;    by 8\n\t"
+      "    mov  %D0, %C0 ;\n\t"
+      "    mov  %C0, %B0 ;\n\t"
+      "    mov  %B0, %A0 ;\n\t"
+      "    clr  %A0      ;\n\t"
+      "    subi %2, 8    ; 8 fewer bits to process\n\t"
+      "    rjmp 4b       ; try the next byte\n\t"
+      "5:\n\t"
+      "3:\n\t"
+      "    lsl  %A0      ; shift\n\t"
+      "    rol  %B0      ;  rem:quot\n\t"
+      "    rol  %C0      ;   left\n\t"
+      "    rol  %D0      ;    by\n\t"
+      "    rol  %A1      ;     1\n\t"
+      "    rol  %B1      ;\n\t"
+      "    rol  %C1      ;\n\t"
+      "    rol  %D1      ;\n\t"
+      "    brcs 1f       ; if carry out, rem > divisor\n\t"
+      "    cp   %A1, %A3 ; is rem less\n\t"
+      "    cpc  %B1, %B3 ;  than\n\t"
+      "    cpc  %C1, %C3 ;   divisor\n\t"
+      "    cpc  %D1, %D3 ;    ?\n\t"
+      "    brcs 2f       ; yes, when carry out\n\t"
+      "1:\n\t"
+      "    sub  %A1, %A3 ; compute\n\t"
+      "    sbc  %B1, %B3 ;  rem -=\n\t"
+      "    sbc  %C1, %C3 ;   divisor\n\t"
+      "    sbc  %D1, %D3 ;\n\t"
+      "    ori  %A0, 1   ; record quotient bit as 1\n\t"
+      "2:\n\t"
+      "    dec  %2       ; next\n\t"
+      "    brne 3b       ;  bit\n\t"
+    : "+d" (udividend), "+r" (rem), "=&d" (counter)
+    : "r" (udivisor)
+    : 
+  );
+  (void)counter;
+  return { udividend, rem };
+#endif
+}
+
+/**
+ * @brief A division function, applicable when the divisor is large
+ * 
+ * This function will work for all combinations of dividend & divisor, but only
+ * apply it when the divisor is large. I.e. >sqrt(max(dividend)).
+ * 
+ * In this situation, on aggregate it's quicker to align the dividend with the divisor
+ * and then divide rather than call the standard divide operator.
+ * 
+ * @tparam T 
+ * @param udividend 
+ * @param udivisor 
+ * @return T 
+ */
+template <typename T>
+static inline T divide_large_divisor(T udividend, T udivisor) {
+  static_assert(type_traits::is_unsigned<T>::value, "T must be unsigned");
+
+#if defined(UNIT_TEST)
+  if (udivisor<=get_large_divisor_threshhold<T>()) { 
+    return 0;
+  }
+#endif
+
+  return divmod_large_divisor(udividend, udivisor).quot;
+}
+
+// ===================== Constant time =====================
+
+// The kernel behind fast_div_ct(): restoring division that runs all 32 steps,
+// whatever the operands, with no data dependent branches. Instead of branching
+// around the subtraction, each step subtracts into a trial register and 
+// conditionally copies it back with sbrs: a skip over a 1 word instruction
+// takes 2 cycles, the same as not skipping & executing it.
+//
+// After k steps the remainder is below 2^k, so the first 8 steps only need
+// a 1 byte remainder, the next 8 steps 2 bytes etc. The inverted quotient bits 
+// are carried into the dividend register, as libgcc's __udivmodsi4 does.
+
+#if defined(AFD_BACKEND_AVR)
+
+// Run one 8 step stage of the constant time division
+#if defined(AFD_FAST_TEXT)
+#define AFD_CT_STAGE(step) ".rept 8\n\t" step ".endr\n\t"
+#elif defined(AFD_SMALL_KERNELS)
+#define AFD_CT_STAGE(step) "    ldi  %3, 8    ; loop counter\n\t" \
+                           "1:\n\t" step \
+                           "    dec  %3       ; next\n\t" \
+                           "    brne 1b       ;  bit\n\t"
+#else
+// Unrolled by 2, a balance between flash & speed
+#define AFD_CT_STAGE(step) "    ldi  %3, 4    ; loop counter\n\t" \
+                           "1:\n\t" step step \
+                           "    dec  %3       ; next 2\n\t" \
+                           "    brne 1b       ;  bits\n\t"
+#endif
+
+// Shift the previous (inverted) quotient bit in & the next dividend bit out
+#define AFD_CT_SHIFT_QUOT \
+        "    rol  %A0      ; shift\n\t" \
+        "    rol  %B0      ;  quot\n\t" \
+        "    rol  %C0      ;   left\n\t" \
+        "    rol  %D0      ;    by 1\n\t"
+// Set __tmp_reg__ to 0xFF if rem<divisor, else 0x00. Leaves C untouched.
+#define AFD_CT_BORROW_MASK \
+        "    sbc  __tmp_reg__, __tmp_reg__ ; borrow mask\n\t"
+
+static inline afd_divmod_t<uint32_t, uint32_t> divmod_constant_time(uint32_t udividend, uint32_t udivisor) {
+  uint32_t rem = 0U;
+  uint32_t trial;
+  uint8_t counter;
+  asm(
+      // Steps 1-8: rem fits 1 byte
+      AFD_CT_STAGE(
+        AFD_CT_SHIFT_QUOT
+        "    rol  %A1      ; shift into rem\n\t"
+        "    mov  %A2, %A1 ; trial\n\t"
+        "    sub  %A2, %A4 ;  = rem\n\t"
+        "    cpc  __zero_reg__, %B4 ;   - divisor\n\t"
+        "    cpc  __zero_reg__, %C4 ;\n\t"
+        "    cpc  __zero_reg__, %D4 ; carry set if rem<divisor\n\t"
+        AFD_CT_BORROW_MASK
+        "    sbrs __tmp_reg__, 0 ; if rem>=divisor\n\t"
+        "    mov  %A1, %A2 ;  rem = trial\n\t"
+      )
+      // Steps 9-16: rem fits 2 bytes
+      AFD_CT_STAGE(
+        AFD_CT_SHIFT_QUOT
+        "    rol  %A1      ; shift\n\t"
+        "    rol  %B1      ;  into rem\n\t"
+        "    movw %A2, %A1 ; trial\n\t"
+        "    sub  %A2, %A4 ;  = rem\n\t"
+        "    sbc  %B2, %B4 ;   - divisor\n\t"
+        "    cpc  __zero_reg__, %C4 ;\n\t"
+        "    cpc  __zero_reg__, %D4 ; carry set if rem<divisor\n\t"
+        AFD_CT_BORROW_MASK
+        "    sbrs __tmp_reg__, 0 ; if rem>=divisor\n\t"
+        "    movw %A1, %A2 ;  rem = trial\n\t"
+      )
+      // Steps 17-24: rem fits 3 bytes
+      AFD_CT_STAGE(
+        AFD_CT_SHIFT_QUOT
+        "    rol  %A1      ; shift\n\t"
+        "    rol  %B1      ;  into\n\t"
+        "    rol  %C1      ;   rem\n\t"
+        "    movw %A2, %A1 ; trial\n\t"
+        "    mov  %C2, %C1 ;  = rem\n\t"
+        "    sub  %A2, %A4 ;   - divisor\n\t"
+        "    sbc  %B2, %B4 ;\n\t"
+        "    sbc  %C2, %C4 ;\n\t"
+        "    cpc  __zero_reg__, %D4 ; carry set if rem<divisor\n\t"
+        AFD_CT_BORROW_MASK
+        "    sbrs __tmp_reg__, 0 ; if rem>=divisor\n\t"
+        "    movw %A1, %A2 ;  rem\n\t"
+        "    sbrs __tmp_reg__, 0 ;\n\t"
+        "    mov  %C1, %C2 ;   = trial\n\t"
+      )
+      // Steps 25-32: rem fits 4 bytes
+      AFD_CT_STAGE(
+        AFD_CT_SHIFT_QUOT
+        "    rol  %A1      ; shift\n\t"
+        "    rol  %B1      ;  into\n\t"
+        "    rol  %C1      ;   rem\n\t"
+        "    rol  %D1      ;\n\t"
+        "    movw %A2, %A1 ; trial\n\t"
+        "    movw %C2, %C1 ;  = rem\n\t"
+        "    sub  %A2, %A4 ;   - divisor\n\t"
+        "    sbc  %B2, %B4 ;\n\t"
+        "    sbc  %C2, %C4 ;\n\t"
+        "    sbc  %D2, %D4 ; carry set if rem<divisor\n\t"
+        AFD_CT_BORROW_MASK
+        "    sbrs __tmp_reg__, 0 ; if rem>=divisor\n\t"
+        "    movw %A1, %A2 ;  rem\n\t"
+        "    sbrs __tmp_reg__, 0 ;\n\t"
+        "    movw %C1, %C2 ;   = trial\n\t"
+      )
+      // Shift in the final quotient bit & un-invert
+      AFD_CT_SHIFT_QUOT
+      "    com  %A0      ; quot\n\t"
+      "    com  %B0      ;  =\n\t"
+      "    com  %C0      ;   ~quot\n\t"
+      "    com  %D0      ;\n\t"
+    : "+r" (udividend), "+r" (rem), "=&r" (trial), "=&d" (counter)
+    : "r" (udivisor)
+    : 
+  );
+  (void)trial;
+  (void)counter;
+  return { udividend, rem };
+}
+
+#undef AFD_CT_STAGE
+#undef AFD_CT_SHIFT_QUOT
+#undef AFD_CT_BORROW_MASK
+
+#elif defined(AFD_BACKEND_RP2040)
+
+// The SIO divider takes 8 cycles for any operands
+static inline afd_divmod_t<uint32_t, uint32_t> divmod_constant_time(uint32_t udividend, uint32_t udivisor) {
+  return divmod_sio(udividend, udivisor);
+}
+
+#else
+
+// Model of the constant time division: always 32 restoring steps. As the assembly,
+// the subtraction is masked by the borrow rather than branched around. Also the
+// AFD_BACKEND_ARMV6M kernel: libgcc's division exits early, so isn't constant time.
+static inline afd_divmod_t<uint32_t, uint32_t> divmod_constant_time(uint32_t udividend, uint32_t udivisor) {
+  uint32_t rem = 0U;
+  for (uint8_t index=0U; index<bit_width<uint32_t>::value; ++index) {
+    rem = (rem << 1U) | (udividend >> 31U);
+    udividend = udividend << 1U;
+    // All ones if rem>=divisor: the inverted borrow out of rem-divisor
+    const uint32_t mask = ~(uint32_t)(((uint64_t)rem - udivisor) >> 32U);
+    rem = rem - (udivisor & mask);
+    udividend = udividend | (mask & 1U);
+  }
+  return { udividend, rem };
+}
+
+#endif
+
 }
\ No newline at end of file
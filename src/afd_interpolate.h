@@ -0,0 +1,275 @@
+#pragma once
+
+/** @file
+ * @brief Table interpolation. See @ref group-afd-interpolate
+*/
+
+#include "avr-fast-div.h"
+#include "afd_divisor.h"
+
+/// @defgroup group-afd-interpolate Table interpolation
+///
+/// @brief 1D linear & 2D bilinear interpolation of lookup tables. E.g. fuel & ignition maps.
+///
+/// Each axis computes ```y0 + (x-x0)*(y1-y0)/(x1-x0)```. The product & division go
+/// through fast_muldiv(), so they use the narrow u24/u8 or u32/u16 kernels rather
+/// than a 32-bit division: the quotient can never exceed |y1-y0|.
+///
+/// Consecutive lookups often land in the same bin (E.g. the engine is at steady
+/// state). Passing an afd_interp_bin per axis caches the bin: if the next lookup
+/// is in it again, the axis search is skipped. For 8-bit axes & values the division
+/// is also a multiplication by the bin width's precomputed reciprocal (an
+/// afd_divisor<uint8_t>): a 16-bit multiply-high instead of the u24/u8 kernel, at
+/// the cost of the afd_divisor setup on every bin change. So for 8-bit tables, use
+/// the uncached form if lookups rarely repeat a bin. Otherwise the product is 32-bit:
+/// a reciprocal's 32x32 multiply-high (plus a u64/u16 setup) would lose to the u32/u16
+/// kernel, so the cached form divides exactly as the uncached one does.
+///
+/// Usage:
+/// @code
+///      static afd_interp_bin<uint16_t, uint8_t> rpmBin, loadBin;
+///      uint8_t ve = fast_interpolate2d(rpmAxis, 16, loadAxis, 16, veTable, rpm, load, rpmBin, loadBin);
+/// @endcode
+///
+/// @warning Axes must be strictly increasing. x values outside an axis are clamped to it.
+/// @note Axis & value types are uint8_t or uint16_t. Results are the same for the cached &
+/// uncached forms. 2D interpolates along x first (both rows), then along y.
+/// @{
+
+namespace avr_fast_div_impl {
+
+  /// @brief Types used to interpolate a TValue table along a TAxis
+  template <typename TAxis, typename TValue>
+  struct interp_traits {
+    static_assert(type_traits::is_unsigned<TAxis>::value && sizeof(TAxis)<=sizeof(uint16_t), "Axis type must be uint8_t or uint16_t");
+    static_assert(type_traits::is_unsigned<TValue>::value && sizeof(TValue)<=sizeof(uint16_t), "Value type must be uint8_t or uint16_t");
+
+    /// @brief (x-x0)*(y1-y0) fits into 16-bits only if both are 8-bit
+    using divisor_t = type_traits::conditional_t<sizeof(TAxis)==sizeof(uint8_t) && sizeof(TValue)==sizeof(uint8_t), uint8_t, uint16_t>;
+    using product_t = typename divisor_traits<divisor_t>::dividend_t;
+  };
+
+  template <typename TAxis>
+  static inline TAxis clamp_axis(const TAxis *pAxis, uint8_t size, TAxis x) {
+    return x<pAxis[0] ? pAxis[0] : (x>pAxis[size-1U] ? pAxis[size-1U] : x);
+  }
+
+  // Index of the bin [pAxis[index], pAxis[index+1]] containing x. x must already be clamped
+  template <typename TAxis>
+  static inline uint8_t find_bin(const TAxis *pAxis, uint8_t size, TAxis x) {
+    uint8_t index = (uint8_t)(size-2U);
+    while (index>0U && x<pAxis[index]) {
+      --index;
+    }
+    return index;
+  }
+
+  // dx*dy/width, where dx<=width
+  static inline uint16_t interp_muldiv(uint8_t dx, uint16_t dy, uint8_t width) {
+    // u24/u8=>u16
+    return fast_muldiv(dy, dx, width);
+  }
+  static inline uint16_t interp_muldiv(uint16_t dx, uint16_t dy, uint16_t width) {
+    // u32/u16=>u16
+    return fast_muldiv(dx, dy, width);
+  }
+
+  /// @brief Scale a value delta by dx/width, using fast_muldiv()
+  template <typename TAxis>
+  struct interp_muldiv_scale {
+    TAxis dx;
+    TAxis width;
+
+    uint16_t operator()(uint16_t dy) const {
+      return interp_muldiv(dx, dy, width);
+    }
+  };
+
+  /// @brief Scale a value delta by dx/width, using a precomputed width
+  template <typename TAxis, typename TValue>
+  struct interp_divisor_scale {
+    using traits = interp_traits<TAxis, TValue>;
+    TAxis dx;
+    const afd_divisor<typename traits::divisor_t> &width;
+
+    uint16_t operator()(uint16_t dy) const {
+      using product_t = typename traits::product_t;
+      return (uint16_t)fast_div((product_t)((product_t)dx * dy), width);
+    }
+  };
+
+  // y0 + (y1-y0)*dx/width. The delta is scaled as unsigned, then added or subtracted
+  template <typename TValue, typename TScale>
+  static inline TValue interpolate(TValue y0, TValue y1, const TScale &scale) {
+    if (y1>=y0) {
+      return (TValue)(y0 + scale((uint16_t)(y1-y0)));
+    }
+    return (TValue)(y0 - scale((uint16_t)(y0-y1)));
+  }
+
+}
+
+/// @brief The axis bin of the previous lookup, plus its width. For 8-bit axes &
+/// values, the width is precomputed for division (an afd_divisor<uint8_t>)
+///
+/// One per axis: the bin refers to the axis it was last used with.
+///
+/// @tparam TAxis Axis type
+/// @tparam TValue Table value type
+template <typename TAxis, typename TValue>
+class afd_interp_bin {
+  using divisor_t = typename avr_fast_div_impl::interp_traits<TAxis, TValue>::divisor_t;
+  // Only a 16-bit product's reciprocal is cheaper than the division kernel
+  static constexpr bool use_reciprocal = sizeof(divisor_t)==sizeof(uint8_t);
+
+public:
+  /// @brief The cached bin width
+  using width_t = type_traits::conditional_t<use_reciprocal, afd_divisor<uint8_t>, TAxis>;
+  /// @brief Scales a value delta by the bin
+  using scale_t = type_traits::conditional_t<use_reciprocal, 
+                                             avr_fast_div_impl::interp_divisor_scale<TAxis, TValue>,
+                                             avr_fast_div_impl::interp_muldiv_scale<TAxis>>;
+
+  /// @brief An empty bin: the first lookup always searches the axis
+  afd_interp_bin(void)
+    : _index(0U)
+    , _lower(1U)
+    , _upper(0U)
+    , _width(0U)
+  {
+  }
+
+  /// @brief Is x within this bin?
+  bool contains(TAxis x) const {
+    return x>=_lower && x<=_upper;
+  }
+
+  /// @brief Move to the bin [pAxis[index], pAxis[index+1]]. For 8-bit axes & values,
+  /// this computes the reciprocal
+  void select(const TAxis *pAxis, uint8_t index) {
+    _index = index;
+    _lower = pAxis[index];
+    _upper = pAxis[index+1U];
+    _width = width_t((divisor_t)(_upper-_lower));
+  }
+
+  /// @brief Index of the bin's lower axis point
+  uint8_t index(void) const {
+    return _index;
+  }
+
+  /// @brief The bin's lower axis value
+  TAxis lower(void) const {
+    return _lower;
+  }
+
+  /// @brief The bin width
+  const width_t& width(void) const {
+    return _width;
+  }
+
+private:
+  uint8_t _index;
+  TAxis _lower;
+  TAxis _upper;
+  width_t _width;
+};
+
+namespace avr_fast_div_impl {
+
+  template <typename TAxis>
+  static inline interp_muldiv_scale<TAxis> find_scale(const TAxis *pAxis, uint8_t size, TAxis x, uint8_t &index) {
+    x = clamp_axis(pAxis, size, x);
+    index = find_bin(pAxis, size, x);
+    return { (TAxis)(x-pAxis[index]), (TAxis)(pAxis[index+1U]-pAxis[index]) };
+  }
+
+  template <typename TAxis, typename TValue>
+  static inline typename afd_interp_bin<TAxis, TValue>::scale_t find_scale(const TAxis *pAxis, uint8_t size, TAxis x, afd_interp_bin<TAxis, TValue> &bin) {
+    x = clamp_axis(pAxis, size, x);
+    if (!bin.contains(x)) {
+      bin.select(pAxis, find_bin(pAxis, size, x));
+    }
+    return { (TAxis)(x-bin.lower()), bin.width() };
+  }
+
+  template <typename TValue, typename TXScale, typename TYScale>
+  static inline TValue interpolate2d(const TValue *pValues, uint8_t xSize, uint8_t xIndex, const TXScale &xScale, uint8_t yIndex, const TYScale &yScale) {
+    const TValue *pRow0 = pValues + ((uint16_t)yIndex * xSize) + xIndex;
+    const TValue *pRow1 = pRow0 + xSize;
+    return interpolate(interpolate(pRow0[0], pRow0[1], xScale),
+                       interpolate(pRow1[0], pRow1[1], xScale),
+                       yScale);
+  }
+
+}
+
+/// @brief 1D linear interpolation
+///
+/// @param pAxis The x axis: size strictly increasing values
+/// @param pValues The table: size values, one per axis point
+/// @param size Number of axis points. At least 2
+/// @param x Where to interpolate
+/// @return The table value at x
+template <typename TAxis, typename TValue>
+static inline TValue fast_interpolate(const TAxis *pAxis, const TValue *pValues, uint8_t size, TAxis x) {
+  uint8_t index;
+  const avr_fast_div_impl::interp_muldiv_scale<TAxis> scale = avr_fast_div_impl::find_scale(pAxis, size, x, index);
+  return avr_fast_div_impl::interpolate(pValues[index], pValues[index+1U], scale);
+}
+
+/// @brief 1D linear interpolation, reusing the bin of the previous lookup if possible
+///
+/// @param pAxis The x axis: size strictly increasing values
+/// @param pValues The table: size values, one per axis point
+/// @param size Number of axis points. At least 2
+/// @param x Where to interpolate
+/// @param bin The cached bin for pAxis. Updated if x is outside it
+/// @return The table value at x
+template <typename TAxis, typename TValue>
+static inline TValue fast_interpolate(const TAxis *pAxis, const TValue *pValues, uint8_t size, TAxis x, afd_interp_bin<TAxis, TValue> &bin) {
+  const typename afd_interp_bin<TAxis, TValue>::scale_t scale = avr_fast_div_impl::find_scale(pAxis, size, x, bin);
+  return avr_fast_div_impl::interpolate(pValues[bin.index()], pValues[bin.index()+1U], scale);
+}
+
+/// @brief 2D bilinear interpolation
+///
+/// @param pXAxis The x axis: xSize strictly increasing values
+/// @param xSize Number of x axis points. At least 2
+/// @param pYAxis The y axis: ySize strictly increasing values
+/// @param ySize Number of y axis points. At least 2
+/// @param pValues The table: ySize rows of xSize values
+/// @param x Where to interpolate along the x axis
+/// @param y Where to interpolate along the y axis
+/// @return The table value at (x, y)
+template <typename TAxis, typename TValue>
+static inline TValue fast_interpolate2d(const TAxis *pXAxis, uint8_t xSize, const TAxis *pYAxis, uint8_t ySize,
+                                        const TValue *pValues, TAxis x, TAxis y) {
+  uint8_t xIndex, yIndex;
+  const avr_fast_div_impl::interp_muldiv_scale<TAxis> xScale = avr_fast_div_impl::find_scale(pXAxis, xSize, x, xIndex);
+  const avr_fast_div_impl::interp_muldiv_scale<TAxis> yScale = avr_fast_div_impl::find_scale(pYAxis, ySize, y, yIndex);
+  return avr_fast_div_impl::interpolate2d(pValues, xSize, xIndex, xScale, yIndex, yScale);
+}
+
+/// @brief 2D bilinear interpolation, reusing the bins of the previous lookup if possible
+///
+/// @param pXAxis The x axis: xSize strictly increasing values
+/// @param xSize Number of x axis points. At least 2
+/// @param pYAxis The y axis: ySize strictly increasing values
+/// @param ySize Number of y axis points. At least 2
+/// @param pValues The table: ySize rows of xSize values
+/// @param x Where to interpolate along the x axis
+/// @param y Where to interpolate along the y axis
+/// @param xBin The cached bin for pXAxis. Updated if x is outside it
+/// @param yBin The cached bin for pYAxis. Updated if y is outside it
+/// @return The table value at (x, y)
+template <typename TAxis, typename TValue>
+static inline TValue fast_interpolate2d(const TAxis *pXAxis, uint8_t xSize, const TAxis *pYAxis, uint8_t ySize,
+                                        const TValue *pValues, TAxis x, TAxis y,
+                                        afd_interp_bin<TAxis, TValue> &xBin, afd_interp_bin<TAxis, TValue> &yBin) {
+  const typename afd_interp_bin<TAxis, TValue>::scale_t xScale = avr_fast_div_impl::find_scale(pXAxis, xSize, x, xBin);
+  const typename afd_interp_bin<TAxis, TValue>::scale_t yScale = avr_fast_div_impl::find_scale(pYAxis, ySize, y, yBin);
+  return avr_fast_div_impl::interpolate2d(pValues, xSize, xBin.index(), xScale, yBin.index(), yScale);
+}
+
+/// @}
@@ -0,0 +1,164 @@
+#pragma once
+
+/** @file
+ * @brief Division for interrupt handlers. See @ref group-afd-isr
+*/
+
+#include "avr-fast-div.h"
+#if defined(USE_OPTIMIZED_DIV)
+#include "afd_implementation.hpp"
+#endif
+
+/// @defgroup group-afd-isr Division for interrupt handlers
+///
+/// @brief fast_div() variants that keep ISR prologues & epilogues small.
+///
+/// When an ISR calls an ordinary function, the compiler can't see which registers the
+/// callee uses, so the ISR saves & restores every call-clobbered register
+/// (r18-r27, r30, r31). With AFD_SMALL_TEXT every fast_div() call is a real call,
+/// so that is 24+ push/pop instructions on top of the division.
+///
+/// fast_div_isr() inlines the dispatch into the caller and calls the division loop
+/// through inline asm with a custom calling convention that lists every register
+/// it touches. The ISR then saves only those:
+///
+/// | Kernel             | Inputs                            | Outputs                             | Clobbers   |
+/// |--------------------|-----------------------------------|-------------------------------------|------------|
+/// | __afd_isr_div32_16 | r25:r22 dividend, r21:r20 divisor | r23:r22 quotient, r25:r24 remainder | r26, SREG  |
+/// | __afd_isr_div16_8  | r25:r24 dividend, r22 divisor     | r24 quotient, r25 remainder         | r26, SREG  |
+///
+/// r0 (__tmp_reg__) & r1 (__zero_reg__) are untouched. The kernels use no RAM and no
+/// stack beyond the return address, so are reentrant. When the quotient doesn't fit
+/// the kernel, fast_div_isr() uses the division operator: avr-gcc also calls
+/// libgcc's division routines with their exact clobber set.
+///
+/// Usage:
+/// @code
+///      ISR(TIMER1_CAPT_vect) {
+///        rpm = fast_div_isr(MICROS_PER_MIN, toothTime);
+///      }
+/// @endcode
+///
+/// @note Unsigned only. No AFD_POW2_DIVISOR, AFD_RECIPROCAL_TABLE or AFD_PROFILE:
+/// fast_div_isr() always takes the shortest path to the division loop.
+/// @note On the other backends, the kernels are the ordinary inline divide().
+/// On RP2040 that is the SIO divider, which is shared by all code on the core:
+/// divide() checks the divider's DIRTY flag & saves/restores the interrupted
+/// division's state, so fast_div_isr() is safe to call from an ISR that
+/// interrupts any other division (the library's, the SDK's or the application's).
+/// @{
+
+#if defined(USE_OPTIMIZED_DIV)
+
+namespace avr_fast_div_impl {
+
+#if defined(AFD_BACKEND_AVR)
+
+// uint32_t/uint16_t => uint16_t. The local register variables pin the operands
+// to the kernel's registers
+static inline uint16_t divide_isr(uint32_t udividend, uint16_t udivisor) {
+  register uint32_t remQuot asm("r22") = udividend;
+  register uint16_t divisor asm("r20") = udivisor;
+  asm(
+      "%~call __afd_isr_div32_16"
+    : "+r" (remQuot)
+    : "r" (divisor)
+    : "r26"
+  );
+  return (uint16_t)remQuot;
+}
+
+// uint16_t/uint8_t => uint8_t
+static inline uint8_t divide_isr(uint16_t udividend, uint8_t udivisor) {
+  register uint16_t remQuot asm("r24") = udividend;
+  register uint8_t divisor asm("r22") = udivisor;
+  asm(
+      "%~call __afd_isr_div16_8"
+    : "+r" (remQuot)
+    : "r" (divisor)
+    : "r26"
+  );
+  return (uint8_t)remQuot;
+}
+
+#else
+
+// On RP2040, divide() uses divmod_sio(), which is ISR safe
+template <typename TDividend, typename TDivisor>
+static inline TDivisor divide_isr(TDividend udividend, TDivisor udivisor) {
+  return divide(udividend, udivisor);
+}
+
+#endif
+
+}
+
+/// @brief As fast_div(uint16_t, uint8_t), with the ISR calling convention
+///
+/// @param udividend The dividend (numerator)
+/// @param udivisor The divisor (denominator)
+/// @return udividend/udivisor
+static inline uint16_t fast_div_isr(uint16_t udividend, uint8_t udivisor) {
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  if (udivisor > (uint8_t)(udividend >> 8U)) {
+    return avr_fast_div_impl::divide_isr(udividend, udivisor);
+  }
+  return udividend / udivisor;
+}
+
+/// @brief As fast_div(uint16_t, uint16_t), with the ISR calling convention
+///
+/// @param udividend The dividend (numerator)
+/// @param udivisor The divisor (denominator)
+/// @return udividend/udivisor
+static inline uint16_t fast_div_isr(uint16_t udividend, uint16_t udivisor) {
+  if (udivisor<=(uint16_t)UINT8_MAX) {
+    return fast_div_isr(udividend, (uint8_t)udivisor);
+  }
+  return udividend / udivisor;
+}
+
+/// @brief As fast_div(uint32_t, uint16_t), with the ISR calling convention
+///
+/// @param udividend The dividend (numerator)
+/// @param udivisor The divisor (denominator)
+/// @return udividend/udivisor
+static inline uint32_t fast_div_isr(uint32_t udividend, uint16_t udivisor) {
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  if (udivisor > (uint16_t)(udividend >> 16U)) {
+    return avr_fast_div_impl::divide_isr(udividend, udivisor);
+  }
+  return udividend / udivisor;
+}
+
+/// @brief As fast_div(uint32_t, uint8_t), with the ISR calling convention
+///
+/// @param udividend The dividend (numerator)
+/// @param udivisor The divisor (denominator)
+/// @return udividend/udivisor
+static inline uint32_t fast_div_isr(uint32_t udividend, uint8_t udivisor) {
+  return fast_div_isr(udividend, (uint16_t)udivisor);
+}
+
+/// @brief As fast_div(uint32_t, uint32_t), with the ISR calling convention
+///
+/// @param udividend The dividend (numerator)
+/// @param udivisor The divisor (denominator)
+/// @return udividend/udivisor
+static inline uint32_t fast_div_isr(uint32_t udividend, uint32_t udivisor) {
+  if (udivisor<=(uint32_t)UINT16_MAX) {
+    return fast_div_isr(udividend, (uint16_t)udivisor);
+  }
+  return udividend / udivisor;
+}
+
+#else
+
+template <typename TDividend, typename TDivisor>
+static inline TDividend fast_div_isr(TDividend udividend, TDivisor udivisor) {
+  return udividend / udivisor;
+}
+
+#endif
+
+/// @}
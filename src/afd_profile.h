@@ -0,0 +1,111 @@
+#pragma once
+
+/** @file
+ * @brief Dispatch path counters. See @ref group-afd-profile
+*/
+
+#include "avr-fast-div.h"
+
+/// @defgroup group-afd-profile Dispatch profiling
+///
+/// @brief Count which internal division path each call takes.
+///
+/// The optimized fast_div(), fast_divmod() & fast_mod() overloads pick between several
+/// implementations at run time. Knowing which ones a real workload hits tells
+/// you whether narrowing your data types would pay off. E.g. a u32/u16 division
+/// that always lands on the native path will not get faster.
+///
+/// Profiling is opt-in: define AFD_PROFILE when building. Without it, none of
+/// this API exists and the library compiles exactly as before.
+///
+/// Usage:
+/// @code
+///      afd_profile_reset();
+///      runWorkload();
+///      const afd_profile_counters_t &counters = afd_profile_get(AFD_PROFILE_DIV_U32_U16);
+///      Serial.println(counters.native);
+/// @endcode
+///
+/// @note Counting is not atomic. If divisions also run in an ISR, read & reset
+/// the counters with interrupts disabled.
+/// @{
+
+#if defined(AFD_PROFILE) && defined(USE_OPTIMIZED_DIV)
+
+#if !defined(AFD_PROFILE_COUNTER_T)
+/// @brief Counter type. Pre-define as uint16_t (or uint8_t) to save RAM.
+#define AFD_PROFILE_COUNTER_T uint32_t
+#endif
+
+/// @brief Number of calls that took each path through one overload
+struct afd_profile_counters_t {
+  /// The divisor was zero: AFD_ZERO_DIVISOR_CHECK was applied
+  AFD_PROFILE_COUNTER_T zero_divisor;
+  /// Forwarded to another (narrower) public overload, which records its own counts
+  AFD_PROFILE_COUNTER_T narrowed;
+  /// The half width kernel: avr_fast_div_impl::divide() or divmod()
+  AFD_PROFILE_COUNTER_T kernel;
+  /// Long division: the upper part first, then the half width kernel
+  AFD_PROFILE_COUNTER_T long_division;
+  /// avr_fast_div_impl::divide_large_divisor() or divmod_large_divisor()
+  AFD_PROFILE_COUNTER_T large_divisor;
+  /// The compiler's native division (libgcc)
+  AFD_PROFILE_COUNTER_T native;
+  /// A power of two divisor, divided by shifting (AFD_POW2_DIVISOR only)
+  AFD_PROFILE_COUNTER_T pow2;
+  /// The quotient didn't fit: a _checked/_sat overload returned its saturated value
+  AFD_PROFILE_COUNTER_T overflow;
+};
+
+/// @brief Identifies the overload a set of counters belongs to
+enum afd_profile_overload_t : uint8_t {
+  AFD_PROFILE_DIV_U8_U8,        ///< fast_div(uint8_t, uint8_t)
+  AFD_PROFILE_DIV_U16_U8,       ///< fast_div(uint16_t, uint8_t)
+  AFD_PROFILE_DIV_U16_U16,      ///< fast_div(uint16_t, uint16_t)
+  AFD_PROFILE_DIV_U32_U8,       ///< fast_div(uint32_t, uint8_t)
+  AFD_PROFILE_DIV_U32_U16,      ///< fast_div(uint32_t, uint16_t)
+  AFD_PROFILE_DIV_U32_U32,      ///< fast_div(uint32_t, uint32_t)
+  AFD_PROFILE_DIV_U64_U8,       ///< fast_div(uint64_t, uint8_t)
+  AFD_PROFILE_DIV_U64_U16,      ///< fast_div(uint64_t, uint16_t)
+  AFD_PROFILE_DIV_U64_U32,      ///< fast_div(uint64_t, uint32_t)
+  AFD_PROFILE_DIV_U64_U64,      ///< fast_div(uint64_t, uint64_t)
+#if defined(AFD_HAS_INT24)
+  AFD_PROFILE_DIV_U24_U8,       ///< fast_div(__uint24, uint8_t)
+  AFD_PROFILE_DIV_U24_U16,      ///< fast_div(__uint24, uint16_t)
+  AFD_PROFILE_DIV_U24_U24,      ///< fast_div(__uint24, __uint24)
+#endif
+  AFD_PROFILE_DIVMOD_U8_U8,     ///< fast_divmod(uint8_t, uint8_t)
+  AFD_PROFILE_DIVMOD_U16_U8,    ///< fast_divmod(uint16_t, uint8_t)
+  AFD_PROFILE_DIVMOD_U16_U16,   ///< fast_divmod(uint16_t, uint16_t)
+  AFD_PROFILE_DIVMOD_U32_U8,    ///< fast_divmod(uint32_t, uint8_t)
+  AFD_PROFILE_DIVMOD_U32_U16,   ///< fast_divmod(uint32_t, uint16_t)
+  AFD_PROFILE_DIVMOD_U32_U32,   ///< fast_divmod(uint32_t, uint32_t)
+  AFD_PROFILE_MOD_U8_U8,        ///< fast_mod(uint8_t, uint8_t)
+  AFD_PROFILE_MOD_U16_U8,       ///< fast_mod(uint16_t, uint8_t)
+  AFD_PROFILE_MOD_U16_U16,      ///< fast_mod(uint16_t, uint16_t)
+  AFD_PROFILE_MOD_U32_U8,       ///< fast_mod(uint32_t, uint8_t)
+  AFD_PROFILE_MOD_U32_U16,      ///< fast_mod(uint32_t, uint16_t)
+  AFD_PROFILE_MOD_U32_U32,      ///< fast_mod(uint32_t, uint32_t)
+  AFD_PROFILE_DIV16_8,          ///< fast_div16_8()
+  AFD_PROFILE_DIV16_8_CHECKED,  ///< fast_div16_8_checked() & fast_div16_8_sat()
+  AFD_PROFILE_DIV32_16,         ///< fast_div32_16()
+  AFD_PROFILE_DIV32_16_CHECKED, ///< fast_div32_16_checked() & fast_div32_16_sat()
+  AFD_PROFILE_INTERNAL,         ///< Shared by fast_muldiv(), fast_div_fixed() & the 64-bit overloads' 32-bit steps
+  AFD_PROFILE_OVERLOAD_COUNT    ///< Number of overloads profiled
+};
+
+/// @brief Read the counters for one overload
+///
+/// Signed overloads are counted under their unsigned equivalent, since they
+/// forward to it.
+///
+/// @param overload The overload
+/// @return The counts accumulated since the last afd_profile_reset()
+const afd_profile_counters_t& afd_profile_get(afd_profile_overload_t overload);
+
+/// @brief Zero all counters
+void afd_profile_reset(void);
+
+#endif
+
+/// @}
@@ -0,0 +1,184 @@
+#pragma once
+
+/** @file
+ * @brief Division with caller asserted operand bounds. See @ref group-afd-range
+*/
+
+#include "avr-fast-div.h"
+#if defined(USE_OPTIMIZED_DIV)
+#include "afd_implementation.hpp"
+#endif
+
+/// @defgroup group-afd-range Division with compile time operand bounds
+///
+/// @brief Resolve the fast_div() dispatch at compile time, from ranges the caller knows.
+///
+/// fast_div() can only see the operand types, so it checks the operand values on
+/// every call to pick a kernel. E.g. fast_div(uint32_t, uint32_t) tests whether the
+/// divisor fits into 16-bits and then whether the quotient does. Often the caller
+/// knows more. E.g. RPM is always less than 20000, tooth time always more than 200.
+/// Declaring those bounds lets the kernel be chosen at compile time: the call
+/// inlines straight to the division loop, with no comparisons & no zero divisor check.
+///
+/// Usage:
+/// @code
+///      // 0 <= toothTime <= 3600000 and 65 <= rpm <= 65535
+///      uint32_t result = fast_div<afd_range<0, 3600000>, afd_range<65, 65535>>(toothTime, rpm);
+/// @endcode
+///
+/// @warning The bounds are a promise: if an operand is outside its range, the result
+/// is wrong. Define AFD_RANGE_CHECK (E.g. in a debug build) to assert() that each
+/// operand is within its range, or define AFD_RANGE_ASSERT(value, lower, upper) to
+/// supply your own check.
+/// @note Operands must be unsigned & no wider than 32-bits.
+/// @note Calls are not counted by AFD_PROFILE, unless they fall back to fast_div().
+/// @{
+
+#if !defined(AFD_RANGE_ASSERT)
+#if defined(AFD_RANGE_CHECK)
+#include <assert.h>
+/**
+ * @brief Check that an operand is within its declared range
+ *
+ * @param value The operand
+ * @param lower Lower bound, inclusive
+ * @param upper Upper bound, inclusive
+ */
+#define AFD_RANGE_ASSERT(value, lower, upper) assert(((value)>=(lower)) && ((value)<=(upper)))
+#else
+#define AFD_RANGE_ASSERT(value, lower, upper)
+#endif
+#endif
+
+/// @brief An inclusive range of operand values, known at compile time
+///
+/// @tparam Lower The smallest value the operand can take
+/// @tparam Upper The largest value the operand can take
+template <uint32_t Lower, uint32_t Upper>
+struct afd_range {
+  static_assert(Lower<=Upper, "Lower bound must not exceed the upper bound");
+  static constexpr uint32_t lower = Lower;
+  static constexpr uint32_t upper = Upper;
+};
+
+namespace avr_fast_div_impl {
+
+  /// @brief The narrowest unsigned type that holds every value up to upper
+  template <uint32_t upper>
+  struct range_type {
+    typedef type_traits::conditional_t<upper<=UINT8_MAX, uint8_t,
+            type_traits::conditional_t<upper<=UINT16_MAX, uint16_t, uint32_t>> type;
+  };
+
+  /// @brief The kernels afd_range division can resolve to
+  enum range_kernel_t {
+    /// @brief The dividend is always less than the divisor: the quotient is zero
+    range_kernel_zero,
+    /// @brief uint16_t/uint8_t => uint8_t
+    range_kernel_u16_u8,
+#if defined(AFD_HAS_INT24)
+    /// @brief __uint24/uint16_t => uint8_t
+    range_kernel_u24_u16,
+    /// @brief __uint24/uint8_t => uint16_t
+    range_kernel_u24_u8,
+#endif
+    /// @brief uint32_t/uint16_t => uint16_t
+    range_kernel_u32_u16,
+    /// @brief No kernel applies to the whole range: fast_div() on the narrowest types
+    range_kernel_runtime,
+  };
+
+  template <range_kernel_t kernel>
+  using range_kernel_tag = type_traits::integral_constant<range_kernel_t, kernel>;
+
+  // The quotient fits into the kernel if the dividend shifted right by the
+  // quotient width is always less than the divisor. That also rules out a zero divisor.
+  static constexpr bool range_quotient_fits(uint32_t dividendUpper, uint8_t quotientBits, uint32_t divisorLower) {
+    return (dividendUpper >> quotientBits) < divisorLower;
+  }
+
+  /// @brief Pick the fastest kernel that is correct for every operand in the ranges.
+  ///
+  /// In order of speed: fewest division steps, then narrowest remainder.
+  template <typename TDividendRange, typename TDivisorRange>
+  static constexpr range_kernel_t select_range_kernel(void) {
+    return TDividendRange::upper<TDivisorRange::lower ? range_kernel_zero
+         : (TDividendRange::upper<=UINT16_MAX && TDivisorRange::upper<=UINT8_MAX
+            && range_quotient_fits(TDividendRange::upper, 8U, TDivisorRange::lower)) ? range_kernel_u16_u8
+#if defined(AFD_HAS_INT24)
+         : (TDividendRange::upper<=0xFFFFFFUL && TDivisorRange::upper<=UINT16_MAX
+            && range_quotient_fits(TDividendRange::upper, 8U, TDivisorRange::lower)) ? range_kernel_u24_u16
+         : (TDividendRange::upper<=0xFFFFFFUL && TDivisorRange::upper<=UINT8_MAX
+            && range_quotient_fits(TDividendRange::upper, 16U, TDivisorRange::lower)) ? range_kernel_u24_u8
+#endif
+         : (TDivisorRange::upper<=UINT16_MAX
+            && range_quotient_fits(TDividendRange::upper, 16U, TDivisorRange::lower)) ? range_kernel_u32_u16
+         : range_kernel_runtime;
+  }
+
+#if defined(USE_OPTIMIZED_DIV)
+
+  template <typename TDividendRange, typename TDivisorRange>
+  static inline uint32_t divide_range(uint32_t, uint32_t, const range_kernel_tag<range_kernel_zero>&) {
+    return 0U;
+  }
+
+  template <typename TDividendRange, typename TDivisorRange>
+  static inline uint32_t divide_range(uint32_t udividend, uint32_t udivisor, const range_kernel_tag<range_kernel_u16_u8>&) {
+    return divide((uint16_t)udividend, (uint8_t)udivisor);
+  }
+
+#if defined(AFD_HAS_INT24)
+  template <typename TDividendRange, typename TDivisorRange>
+  static inline uint32_t divide_range(uint32_t udividend, uint32_t udivisor, const range_kernel_tag<range_kernel_u24_u16>&) {
+    return divide((__uint24)udividend, (uint16_t)udivisor);
+  }
+
+  template <typename TDividendRange, typename TDivisorRange>
+  static inline uint32_t divide_range(uint32_t udividend, uint32_t udivisor, const range_kernel_tag<range_kernel_u24_u8>&) {
+    return divide((__uint24)udividend, (uint8_t)udivisor);
+  }
+#endif
+
+  template <typename TDividendRange, typename TDivisorRange>
+  static inline uint32_t divide_range(uint32_t udividend, uint32_t udivisor, const range_kernel_tag<range_kernel_u32_u16>&) {
+    return divide(udividend, (uint16_t)udivisor);
+  }
+
+  template <typename TDividendRange, typename TDivisorRange>
+  static inline uint32_t divide_range(uint32_t udividend, uint32_t udivisor, const range_kernel_tag<range_kernel_runtime>&) {
+    // The divisor can't be wider than the dividend for fast_div()
+    using divisor_t = typename range_type<TDivisorRange::upper>::type;
+    using dividend_t = typename range_type<(TDividendRange::upper>TDivisorRange::upper ? TDividendRange::upper : TDivisorRange::upper)>::type;
+    return fast_div((dividend_t)udividend, (divisor_t)udivisor);
+  }
+
+#endif
+
+}
+
+/// @brief Unsigned division, with the dispatch resolved at compile time from the operand ranges
+///
+/// @tparam TDividendRange An afd_range<> that contains every dividend value
+/// @tparam TDivisorRange An afd_range<> that contains every divisor value
+/// @param udividend The dividend (numerator)
+/// @param udivisor The divisor (denominator)
+/// @return udividend/udivisor
+template <typename TDividendRange, typename TDivisorRange, typename TDividend, typename TDivisor>
+static inline TDividend fast_div(TDividend udividend, TDivisor udivisor) {
+  static_assert(type_traits::is_unsigned<TDividend>::value && type_traits::is_unsigned<TDivisor>::value, "afd_range operands must be unsigned");
+  static_assert(sizeof(TDividend)<=sizeof(uint32_t) && sizeof(TDivisor)<=sizeof(uint32_t), "afd_range operands must be no wider than 32-bits");
+  static_assert(TDividendRange::upper<=(TDividend)~(TDividend)0U, "Dividend range exceeds the dividend type");
+  static_assert(TDivisorRange::upper<=(TDivisor)~(TDivisor)0U, "Divisor range exceeds the divisor type");
+  AFD_RANGE_ASSERT(udividend, TDividendRange::lower, TDividendRange::upper);
+  AFD_RANGE_ASSERT(udivisor, TDivisorRange::lower, TDivisorRange::upper);
+
+#if defined(USE_OPTIMIZED_DIV)
+  return (TDividend)avr_fast_div_impl::divide_range<TDividendRange, TDivisorRange>(udividend, udivisor,
+            avr_fast_div_impl::range_kernel_tag<avr_fast_div_impl::select_range_kernel<TDividendRange, TDivisorRange>()>());
+#else
+  return udividend / udivisor;
+#endif
+}
+
+/// @}
@@ -0,0 +1,187 @@
+#pragma once
+
+/** @file
+ * @brief Worst case execution time estimates. See @ref group-afd-wcet
+*/
+
+#include "avr-fast-div.h"
+
+/// @defgroup group-afd-wcet Worst case execution time
+///
+/// @brief Compile time estimates of the most cycles a single fast_div() call takes.
+///
+/// For ISR budgets & static timing analysis, the average case doesn't matter:
+/// the slowest path through each overload does. E.g. fast_div(uint32_t, uint16_t)
+/// is usually the 16-bit kernel, but falls back to libgcc when the quotient
+/// won't fit into 16 bits.
+///
+/// Usage:
+/// @code
+///      static_assert(afd_wcet<uint32_t, uint16_t>::cycles < ISR_BUDGET_CYCLES, "Too slow for the ISR");
+/// @endcode
+///
+/// @warning These are modelled, not measured, and haven't yet been verified on any
+/// environment. Each is the longest path through an overload: the division kernels &
+/// libgcc routines counted from their instruction listings, plus an allowance for the
+/// compiler generated code around them (avr_fast_div_impl::wcet_glue()) that has not
+/// been checked against real code generation. test_wcet_performance.cpp is the check:
+/// it searches for worst case inputs to every overload under simavr and fails if a
+/// measured worst case exceeds its bound. Only rely on a bound in a build whose
+/// environment & options have passed that test. The model counts the call & return
+/// on a 3-byte PC device (ATmega2560) and targets -Os & -O3. It does not apply to
+/// unoptimized (-O0) builds.
+/// @{
+
+namespace avr_fast_div_impl {
+
+  // The bounds are the longest path through each overload, summed from the parts
+  // below. The assembly kernels & libgcc routines are counted from their
+  // instruction listings. The compiler generated code around them can't be (it
+  // varies with the optimization level & options), so that is an allowance: an
+  // estimate, not yet checked against a measured worst case.
+
+  /// @brief call + ret on a 3-byte PC device: 5 + 5
+  static constexpr uint16_t wcet_call = 10U;
+
+  /// @brief Allowance for the compiler generated code in one overload: the zero divisor
+  /// & range tests, argument & result moves, pushes & pops of call-saved registers
+  /// & any kernel the compiler didn't inline. 16 cycles, plus 8 per dividend byte.
+  static constexpr uint16_t wcet_glue(uint8_t dividendBytes) {
+    return (uint16_t)(16U + (8U*dividendBytes));
+  }
+
+  // libgcc's restoring division routines, from entry up to the ret (lib1funcs.S):
+  // wcet_call counts the call & ret. The loops are 8 cycles per quotient bit for
+  // QImode, 12 for HImode & 20 for SImode.
+  static constexpr uint16_t wcet_udivmodqi4 = 72U;
+  static constexpr uint16_t wcet_udivmodhi4 = 205U;
+  static constexpr uint16_t wcet_udivmodsi4 = 660U;
+
+  /// @brief The divide_step() kernels (afd_implementation.hpp), run for steps quotient bits.
+  ///
+  /// The longest path through one step is the rem:quot shift (1 cycle per byte), 2
+  /// untaken brcs, the compare & subtract (1 cycle per remainder byte each) & ori.
+  /// Plus 3 cycles for the loop's dec & brne (none when unrolled).
+  static constexpr uint16_t wcet_divide_steps(uint8_t steps, uint8_t remQuotBytes, uint8_t remBytes) {
+    return (uint16_t)(steps * (remQuotBytes + (2U*remBytes) + 3U + 3U));
+  }
+
+  /// @brief The compiled C large divisor division, divmod_large_divisor<T>(): the u24
+  /// & u64 large divisor paths.
+  ///
+  /// align() & the division loop each run at most once per quotient bit. Each iteration
+  /// is at most 6 byte-wise operations on T (compare, subtract, or, 2 shifts & the loop
+  /// test): 8 cycles per byte of T covers them, plus 4 for the branches.
+  static constexpr uint16_t wcet_large_divisor(uint8_t quotBits, uint8_t bytes) {
+    return (uint16_t)(2U * quotBits * ((8U*bytes) + 4U));
+  }
+
+  static constexpr uint16_t wcet_max(uint16_t a, uint16_t b) {
+    return a>b ? a : b;
+  }
+
+  /// @brief One public overload: the call, its glue & the slowest path's cycles
+  static constexpr uint16_t wcet_overload(uint8_t dividendBytes, uint16_t pathCycles) {
+    return (uint16_t)(wcet_call + wcet_glue(dividendBytes) + pathCycles);
+  }
+
+  // path is the slowest path through the overload's body. Calls to other public
+  // overloads are counted at their full bound; inline helpers at their path.
+  template <typename TDividend, typename TDivisor>
+  struct wcet_unsigned;
+
+  // The native division: __udivmodqi4
+  template <> struct wcet_unsigned<uint8_t, uint8_t> {
+    static constexpr uint16_t path = wcet_call + wcet_udivmodqi4;
+    static constexpr uint16_t cycles = wcet_overload(1U, path);
+  };
+  // The 8 step u16/u8 kernel or __udivmodhi4
+  template <> struct wcet_unsigned<uint16_t, uint8_t> {
+    static constexpr uint16_t path = wcet_max(wcet_divide_steps(8U, 2U, 1U), wcet_call + wcet_udivmodhi4);
+    static constexpr uint16_t cycles = wcet_overload(2U, path);
+  };
+  // Narrowed to fast_div(uint16_t, uint8_t), or the large divisor kernel: ldi, 1 byte
+  // skip (12 cycles) & the failed second test (6), then 8 steps
+  template <> struct wcet_unsigned<uint16_t, uint16_t> {
+    static constexpr uint16_t path = wcet_max(wcet_unsigned<uint16_t, uint8_t>::cycles, 19U + wcet_divide_steps(8U, 4U, 2U));
+    static constexpr uint16_t cycles = wcet_overload(2U, path);
+  };
+  // The 8, 16 & 24 step kernels or __udivmodsi4
+  template <> struct wcet_unsigned<uint32_t, uint8_t> {
+    static constexpr uint16_t path = wcet_max(wcet_divide_steps(24U, 4U, 1U), wcet_call + wcet_udivmodsi4);
+    static constexpr uint16_t cycles = wcet_overload(4U, path);
+  };
+  // The 8 & 16 step kernels or __udivmodsi4
+  template <> struct wcet_unsigned<uint32_t, uint16_t> {
+    static constexpr uint16_t path = wcet_max(wcet_divide_steps(16U, 4U, 2U), wcet_call + wcet_udivmodsi4);
+    static constexpr uint16_t cycles = wcet_overload(4U, path);
+  };
+  // As uint32_t/uint16_t, or the large divisor kernel: ldi, at least 2 byte skips (18
+  // cycles each) & the failed test (8), then at most 16 steps
+  template <> struct wcet_unsigned<uint32_t, uint32_t> {
+    static constexpr uint16_t path = wcet_max(wcet_unsigned<uint32_t, uint16_t>::path, 45U + wcet_divide_steps(16U, 8U, 4U));
+    static constexpr uint16_t cycles = wcet_overload(4U, path);
+  };
+  // Narrowed to fast_div(uint32_t, uint32_t), the 32 step u64/u32 kernel, or long 
+  // division: fast_divmod(uint32_t, uint32_t) then the kernel (the slowest)
+  template <> struct wcet_unsigned<uint64_t, uint32_t> {
+    static constexpr uint16_t path = wcet_unsigned<uint32_t, uint32_t>::cycles + wcet_divide_steps(32U, 8U, 4U);
+    static constexpr uint16_t cycles = wcet_overload(8U, path);
+  };
+  // The same body as uint64_t/uint32_t
+  template <> struct wcet_unsigned<uint64_t, uint8_t>  : wcet_unsigned<uint64_t, uint32_t> { };
+  template <> struct wcet_unsigned<uint64_t, uint16_t> : wcet_unsigned<uint64_t, uint32_t> { };
+  // As uint64_t/uint32_t, or the C large divisor division: the quotient is at most 32 bits
+  template <> struct wcet_unsigned<uint64_t, uint64_t> {
+    static constexpr uint16_t path = wcet_max(wcet_unsigned<uint64_t, uint32_t>::path, wcet_large_divisor(32U, 8U));
+    static constexpr uint16_t cycles = wcet_overload(8U, path);
+  };
+#if defined(AFD_HAS_INT24)
+  // The 16 step u24/u8 kernel, or long division: __udivmodqi4 then the kernel
+  template <> struct wcet_unsigned<__uint24, uint8_t> {
+    static constexpr uint16_t path = wcet_call + wcet_udivmodqi4 + wcet_divide_steps(16U, 3U, 1U);
+    static constexpr uint16_t cycles = wcet_overload(3U, path);
+  };
+  // The 8 step u24/u16 kernel, narrowed to fast_div(__uint24, uint8_t), or long
+  // division: fast_divmod(uint16_t, uint16_t) then the kernel
+  template <> struct wcet_unsigned<__uint24, uint16_t> {
+    static constexpr uint16_t path = wcet_max(wcet_unsigned<__uint24, uint8_t>::cycles,
+                                              wcet_unsigned<uint16_t, uint16_t>::cycles + wcet_divide_steps(8U, 3U, 2U));
+    static constexpr uint16_t cycles = wcet_overload(3U, path);
+  };
+  // Narrowed to fast_div(__uint24, uint16_t), or the C large divisor division: the 
+  // quotient is at most 8 bits
+  template <> struct wcet_unsigned<__uint24, __uint24> {
+    static constexpr uint16_t path = wcet_max(wcet_unsigned<__uint24, uint16_t>::cycles, wcet_large_divisor(8U, 3U));
+    static constexpr uint16_t cycles = wcet_overload(3U, path);
+  };
+#endif
+
+  /// @brief Extra cycles the signed overloads spend on taking absolute values
+  /// & negating the result
+  ///
+  /// safe_abs() of both operands & the result's negation: each is a sign test & branch
+  /// (3 cycles) & a negation (2 cycles per byte). Plus 2 cycles per byte to move the
+  /// operands & result.
+  template <typename TDividend>
+  static constexpr uint16_t wcet_signed_overhead(void) {
+    return (uint16_t)((3U*(3U + (2U*sizeof(TDividend)))) + (2U*3U*sizeof(TDividend)));
+  }
+
+}
+
+/// @brief Estimated upper bound on the CPU cycles one fast_div(TDividend, TDivisor)
+/// call takes, for any input. Unverified until test_wcet_performance.cpp passes on
+/// your environment: see @ref group-afd-wcet
+///
+/// @tparam TDividend Dividend type
+/// @tparam TDivisor Divisor type. Same signedness as TDividend
+template <typename TDividend, typename TDivisor>
+struct afd_wcet {
+  static_assert(type_traits::is_signed<TDividend>::value==type_traits::is_signed<TDivisor>::value, "Dividend & divisor must have the same signedness");
+
+  static constexpr uint16_t cycles = (uint16_t)(avr_fast_div_impl::wcet_unsigned<type_traits::make_unsigned_t<TDividend>, type_traits::make_unsigned_t<TDivisor>>::cycles
+                                     + (type_traits::is_signed<TDividend>::value ? avr_fast_div_impl::wcet_signed_overhead<TDividend>() : 0U));
+};
+
+/// @}
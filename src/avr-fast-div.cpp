@@ -3,21 +3,54 @@
 #if defined(USE_OPTIMIZED_DIV)
 
 #include "afd_implementation.hpp"
+#include "afd_profile.h"
+
+// ===================== Profiling =====================
+
+#if defined(AFD_PROFILE)
+
+#include <string.h>
+
+static afd_profile_counters_t profileCounters[AFD_PROFILE_OVERLOAD_COUNT];
+
+const afd_profile_counters_t& afd_profile_get(afd_profile_overload_t overload) {
+  return profileCounters[overload];
+}
+
+void afd_profile_reset(void) {
+  memset(profileCounters, 0, sizeof(profileCounters));
+}
+
+/// @brief Record that one overload took one path
+#define AFD_PROFILE_COUNT(overload, path) (++profileCounters[(overload)].path)
+/// @brief Record a zero divisor. Separate from AFD_ZERO_DIVISOR_CHECK, since that can be overridden
+#define AFD_PROFILE_ZERO(overload, divisor) if ((divisor)==0U) { AFD_PROFILE_COUNT(overload, zero_divisor); }
+/// @brief Pass the calling overload through to a shared helper
+#define AFD_PROFILE_ARG(overload) , (overload)
+/// @brief Receive AFD_PROFILE_ARG()
+#define AFD_PROFILE_PARAM , afd_profile_overload_t profileOverload
+
+#else
+
+#define AFD_PROFILE_COUNT(overload, path)
+#define AFD_PROFILE_ZERO(overload, divisor)
+#define AFD_PROFILE_ARG(overload)
+#define AFD_PROFILE_PARAM
 
-#if !defined(AFD_ZERO_DIVISOR_CHECK)
-/**
- * @brief Check for zero divisor
- * 
- * Defaults to AVR behavior - return zero. However, this macro can
- * be pre-defined by the host code base if you want different behavior.
- * E.g. abort(), throw exception 
- *
- * @param dividend The dividend (numerator)
- * @param divisor The divisor (denominator)
- * @return dividend/divisor
- */
-#define AFD_ZERO_DIVISOR_CHECK(dividend, divisor) \
-  if ((divisor)==0U) { return 0U; }
+#endif
+
+// ===================== Power of two divisors =====================
+
+#if defined(AFD_POW2_DIVISOR)
+/// @brief Shift rather than divide if the divisor is a power of two. Must come after
+/// AFD_ZERO_DIVISOR_CHECK, since zero passes the power of two test.
+#define AFD_POW2_DIVISOR_CHECK(overload, dividend, divisor) \
+  if (avr_fast_div_impl::is_pow2(divisor)) { \
+    AFD_PROFILE_COUNT(overload, pow2); \
+    return avr_fast_div_impl::divide_pow2((dividend), (divisor)); \
+  }
+#else
+#define AFD_POW2_DIVISOR_CHECK(overload, dividend, divisor)
 #endif
 
 // ===================== Public Functions =====================
@@ -28,26 +61,175 @@
 #define AFD_PUBLICAPI_ATTTRIBUTE
 #endif
 
-uint8_t AFD_PUBLICAPI_ATTTRIBUTE fast_div16_8(uint16_t udividend, uint8_t udivisor) {
+// Per overload attributes: pre-define AFD_ATTRIBUTE_<overload> to override
+// AFD_PUBLICAPI_ATTTRIBUTE for one overload (or group). E.g. small code everywhere
+// except an inlined fast_div(uint32_t, uint16_t) in a section of its own:
+//
+//    -DAFD_SMALL_TEXT "-DAFD_ATTRIBUTE_DIV_U32_U16=AFD_INLINE AFD_SECTION(\".text.afd_hot\")"
+//
+// DIV_* & DIVMOD_* name the fast_div() & fast_divmod() overloads, as the
+// AFD_PROFILE_* enumerators. The groups are: NARROW (fast_div16_8(), 
+// fast_div32_16() & their _checked/_sat versions), MOD (fast_mod()),
+// MULDIV (fast_muldiv(), fast_muldiv_sat()), CT (fast_div_ct()) and FIXED
+// (fast_div_fixed()).
+
+/// @brief Allow the compiler to inline the overload into its callers (given LTO). The default without AFD_SMALL_TEXT
+#define AFD_INLINE
+/// @brief Never inline the overload. The default with AFD_SMALL_TEXT
+#define AFD_NOINLINE __attribute__((noinline))
+/// @brief Place the overload in a named section, E.g. for a linker script to put in a specific flash region
+#define AFD_SECTION(name) __attribute__((section(name)))
+
+#define AFD_OVERLOAD_ATTRIBUTE(overload) AFD_ATTRIBUTE_ ## overload
+
+#if !defined(AFD_ATTRIBUTE_NARROW)
+#define AFD_ATTRIBUTE_NARROW AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U8_U8)
+#define AFD_ATTRIBUTE_DIV_U8_U8 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U16_U8)
+#define AFD_ATTRIBUTE_DIV_U16_U8 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U16_U16)
+#define AFD_ATTRIBUTE_DIV_U16_U16 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U32_U8)
+#define AFD_ATTRIBUTE_DIV_U32_U8 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U32_U16)
+#define AFD_ATTRIBUTE_DIV_U32_U16 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U32_U32)
+#define AFD_ATTRIBUTE_DIV_U32_U32 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U64_U8)
+#define AFD_ATTRIBUTE_DIV_U64_U8 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U64_U16)
+#define AFD_ATTRIBUTE_DIV_U64_U16 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U64_U32)
+#define AFD_ATTRIBUTE_DIV_U64_U32 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U64_U64)
+#define AFD_ATTRIBUTE_DIV_U64_U64 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U24_U8)
+#define AFD_ATTRIBUTE_DIV_U24_U8 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U24_U16)
+#define AFD_ATTRIBUTE_DIV_U24_U16 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIV_U24_U24)
+#define AFD_ATTRIBUTE_DIV_U24_U24 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIVMOD_U8_U8)
+#define AFD_ATTRIBUTE_DIVMOD_U8_U8 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIVMOD_U16_U8)
+#define AFD_ATTRIBUTE_DIVMOD_U16_U8 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIVMOD_U16_U16)
+#define AFD_ATTRIBUTE_DIVMOD_U16_U16 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIVMOD_U32_U8)
+#define AFD_ATTRIBUTE_DIVMOD_U32_U8 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIVMOD_U32_U16)
+#define AFD_ATTRIBUTE_DIVMOD_U32_U16 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_DIVMOD_U32_U32)
+#define AFD_ATTRIBUTE_DIVMOD_U32_U32 AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_MOD)
+#define AFD_ATTRIBUTE_MOD AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_MULDIV)
+#define AFD_ATTRIBUTE_MULDIV AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_CT)
+#define AFD_ATTRIBUTE_CT AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+#if !defined(AFD_ATTRIBUTE_FIXED)
+#define AFD_ATTRIBUTE_FIXED AFD_PUBLICAPI_ATTTRIBUTE
+#endif
+
+uint8_t AFD_OVERLOAD_ATTRIBUTE(NARROW) fast_div16_8(uint16_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV16_8, udivisor);
   AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV16_8, kernel);
   return (uint8_t)avr_fast_div_impl::divide(udividend, udivisor);
 }
 
-uint16_t AFD_PUBLICAPI_ATTTRIBUTE fast_div32_16(uint32_t udividend, uint16_t udivisor) {
+uint16_t AFD_OVERLOAD_ATTRIBUTE(NARROW) fast_div32_16(uint32_t udividend, uint16_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV32_16, udivisor);
   AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV32_16, kernel);
   return avr_fast_div_impl::divide(udividend, udivisor);
 }
 
-uint8_t AFD_PUBLICAPI_ATTTRIBUTE fast_div(uint8_t udividend, uint8_t udivisor) {
+bool AFD_OVERLOAD_ATTRIBUTE(NARROW) fast_div16_8_checked(uint16_t udividend, uint8_t udivisor, uint8_t &uresult) {
+  uresult = 0U;
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV16_8_CHECKED, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  // The same test fast_div(uint16_t, uint8_t) uses
+  if (udivisor > (uint8_t)(udividend >> 8U)) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIV16_8_CHECKED, kernel);
+    uresult = (uint8_t)avr_fast_div_impl::divide(udividend, udivisor);
+    return true;
+  }
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV16_8_CHECKED, overflow);
+  uresult = (uint8_t)UINT8_MAX;
+  return false;
+}
+
+uint8_t AFD_OVERLOAD_ATTRIBUTE(NARROW) fast_div16_8_sat(uint16_t udividend, uint8_t udivisor) {
+  uint8_t uresult;
+  (void)fast_div16_8_checked(udividend, udivisor, uresult);
+  return uresult;
+}
+
+bool AFD_OVERLOAD_ATTRIBUTE(NARROW) fast_div32_16_checked(uint32_t udividend, uint16_t udivisor, uint16_t &uresult) {
+  uresult = 0U;
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV32_16_CHECKED, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  // The same test fast_div(uint32_t, uint16_t) uses
+  if (udivisor > (uint16_t)(udividend >> 16U)) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIV32_16_CHECKED, kernel);
+    uresult = avr_fast_div_impl::divide(udividend, udivisor);
+    return true;
+  }
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV32_16_CHECKED, overflow);
+  uresult = (uint16_t)UINT16_MAX;
+  return false;
+}
+
+uint16_t AFD_OVERLOAD_ATTRIBUTE(NARROW) fast_div32_16_sat(uint32_t udividend, uint16_t udivisor) {
+  uint16_t uresult;
+  (void)fast_div32_16_checked(udividend, udivisor, uresult);
+  return uresult;
+}
+
+uint8_t AFD_OVERLOAD_ATTRIBUTE(DIV_U8_U8) fast_div(uint8_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U8_U8, udivisor);
   AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
   // u8/u8 => u8
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U8_U8, native);
   return udividend / udivisor;
 }
 
-uint16_t AFD_PUBLICAPI_ATTTRIBUTE fast_div(uint16_t udividend, uint8_t udivisor) {
+uint16_t AFD_OVERLOAD_ATTRIBUTE(DIV_U16_U8) fast_div(uint16_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U16_U8, udivisor);
   AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  AFD_POW2_DIVISOR_CHECK(AFD_PROFILE_DIV_U16_U8, udividend, udivisor);
+#if defined(AFD_RECIPROCAL_TABLE)
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U16_U8, kernel);
+  return avr_fast_div_impl::divide_reciprocal(udividend, udivisor);
+#else
   // Use u16/u8=>u8 if possible
   if (udivisor > (uint8_t)(udividend >> 8U)) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U16_U8, kernel);
     return avr_fast_div_impl::divide(udividend, udivisor);
   } 
   // We now know:
@@ -55,48 +237,567 @@ uint16_t AFD_PUBLICAPI_ATTTRIBUTE fast_div(uint16_t udividend, uint8_t udivisor)
   // && (udivisor<255U)
 
   // u16/u16=>u16
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U16_U8, native);
   return udividend / udivisor;
+#endif
 }
 
-uint16_t AFD_PUBLICAPI_ATTTRIBUTE fast_div(uint16_t udividend, uint16_t udivisor) {
+uint16_t AFD_OVERLOAD_ATTRIBUTE(DIV_U16_U16) fast_div(uint16_t udividend, uint16_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U16_U16, udivisor);
   AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
   if (udivisor<=(uint16_t)UINT8_MAX) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U16_U16, narrowed);
     return fast_div(udividend, (uint8_t)udivisor);
   }
   // We now know that udivisor > 255U. I.e. upper word bits are set
+  AFD_POW2_DIVISOR_CHECK(AFD_PROFILE_DIV_U16_U16, udividend, udivisor);
   // u16/u16=>u16
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U16_U16, large_divisor);
   return avr_fast_div_impl::divide_large_divisor(udividend, udivisor);
 }
 
-static inline uint32_t fast_divu32u16(uint32_t udividend, uint16_t udivisor) {
-    // Use u32/u16=>u16 if possible
+static inline uint32_t fast_divu32u16(uint32_t udividend, uint16_t udivisor AFD_PROFILE_PARAM) {
+  AFD_POW2_DIVISOR_CHECK(profileOverload, udividend, udivisor);
+#if defined(AFD_HAS_INT24)
+  // Use u24/u16=>u8 if possible: half the steps of u32/u16=>u16
+  if ((udividend >> 8U) < udivisor) {
+    AFD_PROFILE_COUNT(profileOverload, kernel);
+    return avr_fast_div_impl::divide_narrow<uint8_t>(udividend, udivisor);
+  }
+#endif
+  // Use u32/u16=>u16 if possible
   if (udivisor > (uint16_t)(udividend >> 16U)) {
+    AFD_PROFILE_COUNT(profileOverload, kernel);
     return avr_fast_div_impl::divide(udividend, udivisor);
   }
   // We now know that udividend > udivisor * 65536U
   // u32/u32=>u32
+  AFD_PROFILE_COUNT(profileOverload, native);
   return udividend / udivisor;
 }
 
-uint32_t AFD_PUBLICAPI_ATTTRIBUTE fast_div(uint32_t udividend, uint16_t udivisor) {
+uint32_t AFD_OVERLOAD_ATTRIBUTE(DIV_U32_U16) fast_div(uint32_t udividend, uint16_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U32_U16, udivisor);
   AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
-  return fast_divu32u16(udividend, udivisor);
+  return fast_divu32u16(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIV_U32_U16));
 }
 
-uint32_t AFD_PUBLICAPI_ATTTRIBUTE fast_div(uint32_t udividend, uint8_t udivisor) {
-  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
-  return fast_divu32u16(udividend, udivisor);
+static inline uint32_t fast_divu32u8(uint32_t udividend, uint8_t udivisor AFD_PROFILE_PARAM) {
+  AFD_POW2_DIVISOR_CHECK(profileOverload, udividend, udivisor);
+  // Use u16/u8=>u8 if possible: the dividend's upper word is zero
+  if ((udividend >> 8U) < udivisor) {
+    AFD_PROFILE_COUNT(profileOverload, kernel);
+    return avr_fast_div_impl::divide_narrow<uint8_t>(udividend, udivisor);
+  }
+  // Use u32/u16=>u16 if possible
+  if ((uint16_t)(udividend >> 16U) < udivisor) {
+    AFD_PROFILE_COUNT(profileOverload, kernel);
+    return avr_fast_div_impl::divide(udividend, (uint16_t)udivisor);
+  }
+#if defined(AFD_BACKEND_AVR) || defined(AFD_BACKEND_C_MODEL)
+  // Use u32/u8=>u24 if possible. On the ARM backends, the division operator is quicker
+  if ((uint8_t)(udividend >> 24U) < udivisor) {
+    AFD_PROFILE_COUNT(profileOverload, kernel);
+    return avr_fast_div_impl::divide_rem_quot_bytes<3U>(udividend, udivisor) & 0x00FFFFFFUL;
+  }
+#endif
+  // We now know that udividend > udivisor * 16777216U
+  // u32/u32=>u32
+  AFD_PROFILE_COUNT(profileOverload, native);
+  return udividend / udivisor;
 }
 
-uint32_t AFD_PUBLICAPI_ATTTRIBUTE fast_div(uint32_t udividend, uint32_t udivisor) {
+uint32_t AFD_OVERLOAD_ATTRIBUTE(DIV_U32_U8) fast_div(uint32_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U32_U8, udivisor);
   AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+#if defined(AFD_RECIPROCAL_TABLE)
+  AFD_POW2_DIVISOR_CHECK(AFD_PROFILE_DIV_U32_U8, udividend, udivisor);
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U32_U8, kernel);
+  return avr_fast_div_impl::divide_reciprocal(udividend, udivisor);
+#else
+  return fast_divu32u8(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIV_U32_U8));
+#endif
+}
+
+static inline uint32_t fast_divu32u32(uint32_t udividend, uint32_t udivisor AFD_PROFILE_PARAM) {
   // Shrink to u32/u16=>u32 if possible
   if (udivisor<=(uint32_t)UINT16_MAX) {
-    return fast_divu32u16(udividend, (uint16_t)udivisor);
+    return fast_divu32u16(udividend, (uint16_t)udivisor AFD_PROFILE_ARG(profileOverload));
   }
   // We now know that udivisor > 65535U. I.e. upper word bits are set
+  AFD_POW2_DIVISOR_CHECK(profileOverload, udividend, udivisor);
   // u32/u32=>u32
+  AFD_PROFILE_COUNT(profileOverload, large_divisor);
   return avr_fast_div_impl::divide_large_divisor<uint32_t>(udividend, udivisor);
 }
 
+uint32_t AFD_OVERLOAD_ATTRIBUTE(DIV_U32_U32) fast_div(uint32_t udividend, uint32_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U32_U32, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  return fast_divu32u32(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIV_U32_U32));
+}
+
+// Defined with the fast_divmod() overloads, below
+static inline afd_divmod_t<uint32_t, uint32_t> fast_divmodu32u32(uint32_t udividend, uint32_t udivisor AFD_PROFILE_PARAM);
+
+static inline uint64_t fast_divu64u32(uint64_t udividend, uint32_t udivisor AFD_PROFILE_PARAM) {
+  const uint32_t upper = (uint32_t)(udividend >> 32U);
+  // Shrink to u32/u32=>u32 if possible
+  if (upper==0U) {
+    AFD_PROFILE_COUNT(profileOverload, narrowed);
+    return fast_divu32u32((uint32_t)udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_INTERNAL));
+  }
+  AFD_POW2_DIVISOR_CHECK(profileOverload, udividend, udivisor);
+  // Use u64/u32=>u32 if possible
+  if (udivisor > upper) {
+    AFD_PROFILE_COUNT(profileOverload, kernel);
+    return avr_fast_div_impl::divide(udividend, udivisor);
+  }
+  // We now know that udividend >= udivisor * 2^32. 
+  // Long division: divide the upper word, then the remainder:lower word.
+  // Since the remainder is less than udivisor, that fits u64/u32=>u32
+  AFD_PROFILE_COUNT(profileOverload, long_division);
+  afd_divmod_t<uint32_t, uint32_t> upperResult = fast_divmodu32u32(upper, udivisor AFD_PROFILE_ARG(AFD_PROFILE_INTERNAL));
+  uint32_t lower = avr_fast_div_impl::divide(((uint64_t)upperResult.rem << 32U) | (uint32_t)udividend, udivisor);
+  return ((uint64_t)upperResult.quot << 32U) | lower;
+}
+
+uint64_t AFD_OVERLOAD_ATTRIBUTE(DIV_U64_U8) fast_div(uint64_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U64_U8, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  return fast_divu64u32(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIV_U64_U8));
+}
+
+uint64_t AFD_OVERLOAD_ATTRIBUTE(DIV_U64_U16) fast_div(uint64_t udividend, uint16_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U64_U16, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  return fast_divu64u32(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIV_U64_U16));
+}
+
+uint64_t AFD_OVERLOAD_ATTRIBUTE(DIV_U64_U32) fast_div(uint64_t udividend, uint32_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U64_U32, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  return fast_divu64u32(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIV_U64_U32));
+}
+
+uint64_t AFD_OVERLOAD_ATTRIBUTE(DIV_U64_U64) fast_div(uint64_t udividend, uint64_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U64_U64, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  // Shrink to u64/u32=>u64 if possible
+  if (udivisor<=(uint64_t)UINT32_MAX) {
+    return fast_divu64u32(udividend, (uint32_t)udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIV_U64_U64));
+  }
+  // We now know that udivisor > UINT32_MAX. I.e. upper dword bits are set
+  AFD_POW2_DIVISOR_CHECK(AFD_PROFILE_DIV_U64_U64, udividend, udivisor);
+  // u64/u64=>u64
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U64_U64, large_divisor);
+  return avr_fast_div_impl::divide_large_divisor<uint64_t>(udividend, udivisor);
+}
+
+#if defined(AFD_HAS_INT24)
+
+__uint24 AFD_OVERLOAD_ATTRIBUTE(DIV_U24_U8) fast_div(__uint24 udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U24_U8, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  AFD_POW2_DIVISOR_CHECK(AFD_PROFILE_DIV_U24_U8, udividend, udivisor);
+  const uint8_t upper = (uint8_t)(udividend >> 16U);
+  // Use u24/u8=>u16 if possible
+  if (udivisor > upper) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U24_U8, kernel);
+    return avr_fast_div_impl::divide(udividend, udivisor);
+  }
+  // Long division: divide the upper byte, then the remainder:lower word.
+  // Since the remainder is less than udivisor, that fits u24/u8=>u16
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U24_U8, long_division);
+  const uint8_t upperQuot = (uint8_t)(upper / udivisor);
+  const uint8_t upperRem = (uint8_t)(upper % udivisor);
+  uint16_t lower = avr_fast_div_impl::divide((__uint24)(((__uint24)upperRem << 16U) | (uint16_t)udividend), udivisor);
+  return (__uint24)(((__uint24)upperQuot << 16U) | lower);
+}
+
+__uint24 AFD_OVERLOAD_ATTRIBUTE(DIV_U24_U16) fast_div(__uint24 udividend, uint16_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U24_U16, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  AFD_POW2_DIVISOR_CHECK(AFD_PROFILE_DIV_U24_U16, udividend, udivisor);
+  const uint16_t upper = (uint16_t)(udividend >> 8U);
+  // Use u24/u16=>u8 if possible
+  if (udivisor > upper) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U24_U16, kernel);
+    return avr_fast_div_impl::divide(udividend, udivisor);
+  }
+  // Use u24/u8=>u16 if possible
+  if (udivisor<=(uint16_t)UINT8_MAX) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U24_U16, narrowed);
+    return fast_div(udividend, (uint8_t)udivisor);
+  }
+  // Long division: divide the upper word, then the remainder:lower byte.
+  // Since the remainder is less than udivisor, that fits u24/u16=>u8
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U24_U16, long_division);
+  afd_divmod_t<uint16_t, uint16_t> upperResult = fast_divmod(upper, udivisor);
+  uint8_t lower = avr_fast_div_impl::divide((__uint24)(((__uint24)upperResult.rem << 8U) | (uint8_t)udividend), udivisor);
+  return (__uint24)(((__uint24)upperResult.quot << 8U) | lower);
+}
+
+__uint24 AFD_OVERLOAD_ATTRIBUTE(DIV_U24_U24) fast_div(__uint24 udividend, __uint24 udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIV_U24_U24, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  // Shrink to u24/u16=>u24 if possible
+  if (udivisor<=(__uint24)UINT16_MAX) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U24_U24, narrowed);
+    return fast_div(udividend, (uint16_t)udivisor);
+  }
+  // We now know that udivisor > 65535U. I.e. upper byte bits are set
+  AFD_POW2_DIVISOR_CHECK(AFD_PROFILE_DIV_U24_U24, udividend, udivisor);
+  // u24/u24=>u24
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIV_U24_U24, large_divisor);
+  return avr_fast_div_impl::divide_large_divisor<__uint24>(udividend, udivisor);
+}
+
+#endif
+
+// ===================== fast_divmod() =====================
+
+afd_divmod_t<uint8_t, uint8_t> AFD_OVERLOAD_ATTRIBUTE(DIVMOD_U8_U8) fast_divmod(uint8_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIVMOD_U8_U8, udivisor);
+  AFD_ZERO_DIVISOR_CHECK_DIVMOD(udividend, udivisor);
+  // u8/u8 => u8
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIVMOD_U8_U8, native);
+  return { (uint8_t)(udividend / udivisor), (uint8_t)(udividend % udivisor) };
+}
+
+afd_divmod_t<uint16_t, uint8_t> AFD_OVERLOAD_ATTRIBUTE(DIVMOD_U16_U8) fast_divmod(uint16_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIVMOD_U16_U8, udivisor);
+  AFD_ZERO_DIVISOR_CHECK_DIVMOD(udividend, udivisor);
+  // Use u16/u8=>u8 if possible
+  if (udivisor > (uint8_t)(udividend >> 8U)) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIVMOD_U16_U8, kernel);
+    afd_divmod_t<uint8_t, uint8_t> result = avr_fast_div_impl::divmod(udividend, udivisor);
+    return { result.quot, result.rem };
+  } 
+  // u16/u16=>u16. The compiler will merge these into a single __udivmodhi4 call
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIVMOD_U16_U8, native);
+  return { (uint16_t)(udividend / udivisor), (uint8_t)(udividend % udivisor) };
+}
+
+afd_divmod_t<uint16_t, uint16_t> AFD_OVERLOAD_ATTRIBUTE(DIVMOD_U16_U16) fast_divmod(uint16_t udividend, uint16_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIVMOD_U16_U16, udivisor);
+  AFD_ZERO_DIVISOR_CHECK_DIVMOD(udividend, udivisor);
+  if (udivisor<=(uint16_t)UINT8_MAX) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_DIVMOD_U16_U16, narrowed);
+    afd_divmod_t<uint16_t, uint8_t> result = fast_divmod(udividend, (uint8_t)udivisor);
+    return { result.quot, result.rem };
+  }
+  // u16/u16=>u16
+  AFD_PROFILE_COUNT(AFD_PROFILE_DIVMOD_U16_U16, large_divisor);
+  return avr_fast_div_impl::divmod_large_divisor(udividend, udivisor);
+}
+
+static inline afd_divmod_t<uint32_t, uint16_t> fast_divmodu32u16(uint32_t udividend, uint16_t udivisor AFD_PROFILE_PARAM) {
+  // Use u32/u16=>u16 if possible
+  if (udivisor > (uint16_t)(udividend >> 16U)) {
+    AFD_PROFILE_COUNT(profileOverload, kernel);
+    afd_divmod_t<uint16_t, uint16_t> result = avr_fast_div_impl::divmod(udividend, udivisor);
+    return { result.quot, result.rem };
+  }
+  // u32/u32=>u32. The compiler will merge these into a single __udivmodsi4 call
+  AFD_PROFILE_COUNT(profileOverload, native);
+  return { udividend / udivisor, (uint16_t)(udividend % udivisor) };
+}
+
+afd_divmod_t<uint32_t, uint8_t> AFD_OVERLOAD_ATTRIBUTE(DIVMOD_U32_U8) fast_divmod(uint32_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIVMOD_U32_U8, udivisor);
+  AFD_ZERO_DIVISOR_CHECK_DIVMOD(udividend, udivisor);
+  afd_divmod_t<uint32_t, uint16_t> result = fast_divmodu32u16(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIVMOD_U32_U8));
+  return { result.quot, (uint8_t)result.rem };
+}
+
+afd_divmod_t<uint32_t, uint16_t> AFD_OVERLOAD_ATTRIBUTE(DIVMOD_U32_U16) fast_divmod(uint32_t udividend, uint16_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIVMOD_U32_U16, udivisor);
+  AFD_ZERO_DIVISOR_CHECK_DIVMOD(udividend, udivisor);
+  return fast_divmodu32u16(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIVMOD_U32_U16));
+}
+
+static inline afd_divmod_t<uint32_t, uint32_t> fast_divmodu32u32(uint32_t udividend, uint32_t udivisor AFD_PROFILE_PARAM) {
+  // Shrink to u32/u16=>u32 if possible
+  if (udivisor<=(uint32_t)UINT16_MAX) {
+    afd_divmod_t<uint32_t, uint16_t> result = fast_divmodu32u16(udividend, (uint16_t)udivisor AFD_PROFILE_ARG(profileOverload));
+    return { result.quot, result.rem };
+  }
+  // u32/u32=>u32
+  AFD_PROFILE_COUNT(profileOverload, large_divisor);
+  return avr_fast_div_impl::divmod_large_divisor(udividend, udivisor);
+}
+
+afd_divmod_t<uint32_t, uint32_t> AFD_OVERLOAD_ATTRIBUTE(DIVMOD_U32_U32) fast_divmod(uint32_t udividend, uint32_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_DIVMOD_U32_U32, udivisor);
+  AFD_ZERO_DIVISOR_CHECK_DIVMOD(udividend, udivisor);
+  return fast_divmodu32u32(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_DIVMOD_U32_U32));
+}
+
+// ===================== fast_mod() =====================
+
+uint8_t AFD_OVERLOAD_ATTRIBUTE(MOD) fast_mod(uint8_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_MOD_U8_U8, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  // u8%u8 => u8
+  AFD_PROFILE_COUNT(AFD_PROFILE_MOD_U8_U8, native);
+  return udividend % udivisor;
+}
+
+uint8_t AFD_OVERLOAD_ATTRIBUTE(MOD) fast_mod(uint16_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_MOD_U16_U8, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  // If the quotient won't fit into a u8, reduce the upper byte first.
+  // (a*256+b)%d == ((a%d)*256+b)%d
+  uint8_t upper = (uint8_t)(udividend >> 8U);
+  if (udivisor <= upper) {
+    // u8%u8 => u8
+    AFD_PROFILE_COUNT(AFD_PROFILE_MOD_U16_U8, long_division);
+    upper = upper % udivisor;
+  } else {
+    AFD_PROFILE_COUNT(AFD_PROFILE_MOD_U16_U8, kernel);
+  }
+  // We now know upper<udivisor, so u16/u8=>u8 applies
+  return avr_fast_div_impl::divmod((uint16_t)(((uint16_t)upper << 8U) | (uint8_t)udividend), udivisor).rem;
+}
+
+uint16_t AFD_OVERLOAD_ATTRIBUTE(MOD) fast_mod(uint16_t udividend, uint16_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_MOD_U16_U16, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  if (udivisor<=(uint16_t)UINT8_MAX) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_MOD_U16_U16, narrowed);
+    return fast_mod(udividend, (uint8_t)udivisor);
+  }
+  // We now know that udivisor > 255U. I.e. upper word bits are set
+  AFD_PROFILE_COUNT(AFD_PROFILE_MOD_U16_U16, large_divisor);
+  return avr_fast_div_impl::divmod_large_divisor(udividend, udivisor).rem;
+}
+
+static inline uint16_t fast_modu32u16(uint32_t udividend, uint16_t udivisor AFD_PROFILE_PARAM) {
+  // If the quotient won't fit into a u16, reduce the upper word first.
+  // (a*65536+b)%d == ((a%d)*65536+b)%d
+  uint16_t upper = (uint16_t)(udividend >> 16U);
+  if (udivisor <= upper) {
+    AFD_PROFILE_COUNT(profileOverload, long_division);
+    upper = fast_mod(upper, udivisor);
+  } else {
+    AFD_PROFILE_COUNT(profileOverload, kernel);
+  }
+  // We now know upper<udivisor, so u32/u16=>u16 applies
+  return avr_fast_div_impl::divmod(((uint32_t)upper << 16U) | (uint16_t)udividend, udivisor).rem;
+}
+
+uint8_t AFD_OVERLOAD_ATTRIBUTE(MOD) fast_mod(uint32_t udividend, uint8_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_MOD_U32_U8, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  return (uint8_t)fast_modu32u16(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_MOD_U32_U8));
+}
+
+uint16_t AFD_OVERLOAD_ATTRIBUTE(MOD) fast_mod(uint32_t udividend, uint16_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_MOD_U32_U16, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  return fast_modu32u16(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_MOD_U32_U16));
+}
+
+uint32_t AFD_OVERLOAD_ATTRIBUTE(MOD) fast_mod(uint32_t udividend, uint32_t udivisor) {
+  AFD_PROFILE_ZERO(AFD_PROFILE_MOD_U32_U32, udivisor);
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  // Shrink to u32%u16 if possible
+  if (udivisor<=(uint32_t)UINT16_MAX) {
+    return fast_modu32u16(udividend, (uint16_t)udivisor AFD_PROFILE_ARG(AFD_PROFILE_MOD_U32_U32));
+  }
+  // We now know that udivisor > 65535U. I.e. upper word bits are set
+  AFD_PROFILE_COUNT(AFD_PROFILE_MOD_U32_U32, large_divisor);
+  return avr_fast_div_impl::divmod_large_divisor(udividend, udivisor).rem;
+}
+
+// ===================== fast_muldiv() =====================
+
+// The quotient won't fit into 16-bits, so muldiv_rem_quot() left the product: divide
+// it & truncate the quotient, the same as (uint16_t)((uint32_t)a*b/c)
+static inline uint16_t muldiv_truncated(uint32_t product, uint16_t udivisor) {
+  return (uint16_t)fast_divu32u16(product, udivisor AFD_PROFILE_ARG(AFD_PROFILE_INTERNAL));
+}
+
+uint16_t AFD_OVERLOAD_ATTRIBUTE(MULDIV) fast_muldiv(uint16_t a, uint16_t b, uint16_t udivisor) {
+  AFD_ZERO_DIVISOR_CHECK(a, udivisor);
+  uint32_t remQuot;
+  if (avr_fast_div_impl::muldiv_rem_quot(a, b, udivisor, remQuot)) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_INTERNAL, kernel);
+    return (uint16_t)remQuot;
+  }
+  return muldiv_truncated(remQuot, udivisor);
+}
+
+uint16_t AFD_OVERLOAD_ATTRIBUTE(MULDIV) fast_muldiv(uint16_t a, uint8_t b, uint8_t udivisor) {
+  AFD_ZERO_DIVISOR_CHECK(a, udivisor);
+  uint32_t remQuot;
+  if (avr_fast_div_impl::muldiv_rem_quot(a, b, udivisor, remQuot)) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_INTERNAL, kernel);
+    return (uint16_t)remQuot;
+  }
+  return muldiv_truncated(remQuot, udivisor);
+}
+
+uint16_t AFD_OVERLOAD_ATTRIBUTE(MULDIV) fast_muldiv_sat(uint16_t a, uint16_t b, uint16_t udivisor) {
+  AFD_ZERO_DIVISOR_CHECK(a, udivisor);
+  uint32_t remQuot;
+  if (avr_fast_div_impl::muldiv_rem_quot(a, b, udivisor, remQuot)) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_INTERNAL, kernel);
+    return (uint16_t)remQuot;
+  }
+  // No need to divide: the quotient is at least 65536
+  AFD_PROFILE_COUNT(AFD_PROFILE_INTERNAL, overflow);
+  return (uint16_t)UINT16_MAX;
+}
+
+uint16_t AFD_OVERLOAD_ATTRIBUTE(MULDIV) fast_muldiv_sat(uint16_t a, uint8_t b, uint8_t udivisor) {
+  AFD_ZERO_DIVISOR_CHECK(a, udivisor);
+  uint32_t remQuot;
+  if (avr_fast_div_impl::muldiv_rem_quot(a, b, udivisor, remQuot)) {
+    AFD_PROFILE_COUNT(AFD_PROFILE_INTERNAL, kernel);
+    return (uint16_t)remQuot;
+  }
+  AFD_PROFILE_COUNT(AFD_PROFILE_INTERNAL, overflow);
+  return (uint16_t)UINT16_MAX;
+}
+
+// ===================== fast_div_ct() =====================
+
+uint32_t AFD_OVERLOAD_ATTRIBUTE(CT) fast_div_ct(uint32_t udividend, uint32_t udivisor) {
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  return avr_fast_div_impl::divmod_constant_time(udividend, udivisor).quot;
+}
+
+// ===================== fast_div_isr() =====================
+
+#if defined(AFD_BACKEND_AVR)
+
+// The kernels behind fast_div_isr(). These have their own calling convention (see
+// afd_isr.h): the caller's inline asm names every register they touch, so an ISR
+// only saves those. They use no RAM, and no stack beyond the return address.
+#if defined(AFD_FAST_TEXT)
+#define AFD_ISR_LOOP_BEGIN(count) ".rept " #count "\n\t"
+#define AFD_ISR_LOOP_END          ".endr\n\t"
+#else
+#define AFD_ISR_LOOP_BEGIN(count) "    ldi  r26, " #count " ; loop counter\n\t" \
+                                  "3:\n\t"
+#define AFD_ISR_LOOP_END          "    dec  r26      ; next\n\t" \
+                                  "    brne 3b       ;  bit\n\t"
+#endif
+
+// In: r25:r22 dividend, r21:r20 divisor. Out: r23:r22 quotient, r25:r24 remainder
+asm(
+    ".pushsection .text.__afd_isr_div32_16,\"ax\",@progbits\n\t"
+    ".global __afd_isr_div32_16\n\t"
+    ".type __afd_isr_div32_16, @function\n"
+    "__afd_isr_div32_16:\n\t"
+    AFD_ISR_LOOP_BEGIN(16)
+    "    lsl  r22      ; shift\n\t"
+    "    rol  r23      ;  rem:quot\n\t"
+    "    rol  r24      ;   left\n\t"
+    "    rol  r25      ;    by 1\n\t"
+    "    brcs 1f       ; if carry out, rem > divisor\n\t"
+    "    cp   r24, r20 ; is rem less\n\t"
+    "    cpc  r25, r21 ;  than divisor ?\n\t"
+    "    brcs 2f       ; yes, when carry out\n\t"
+    "1:\n\t"
+    "    sub  r24, r20 ; compute\n\t"
+    "    sbc  r25, r21 ;  rem -= divisor\n\t"
+    "    ori  r22, 1   ; record quotient bit as 1\n\t"
+    "2:\n\t"
+    AFD_ISR_LOOP_END
+    "    ret\n\t"
+    ".size __afd_isr_div32_16, .-__afd_isr_div32_16\n\t"
+    ".popsection\n\t"
+);
+
+// In: r25:r24 dividend, r22 divisor. Out: r24 quotient, r25 remainder
+asm(
+    ".pushsection .text.__afd_isr_div16_8,\"ax\",@progbits\n\t"
+    ".global __afd_isr_div16_8\n\t"
+    ".type __afd_isr_div16_8, @function\n"
+    "__afd_isr_div16_8:\n\t"
+    AFD_ISR_LOOP_BEGIN(8)
+    "    lsl  r24      ; shift\n\t"
+    "    rol  r25      ;  rem:quot\n\t"
+    "    brcs 1f       ; if carry out, rem > divisor\n\t"
+    "    cp   r25, r22 ; is rem less than divisor?\n\t"
+    "    brcs 2f       ; yes, when carry out\n\t"
+    "1:\n\t"
+    "    sub  r25, r22 ; compute rem -= divisor\n\t"
+    "    ori  r24, 1   ; record quotient bit as 1\n\t"
+    "2:\n\t"
+    AFD_ISR_LOOP_END
+    "    ret\n\t"
+    ".size __afd_isr_div16_8, .-__afd_isr_div16_8\n\t"
+    ".popsection\n\t"
+);
+
+#undef AFD_ISR_LOOP_BEGIN
+#undef AFD_ISR_LOOP_END
+
+#endif
+
+// ===================== fast_div_fixed() =====================
+
+// (dividend << shift)/divisor is computed by long division: the integer part is
+// dividend/divisor, then extra division steps generate the fractional bits from the
+// remainder. So no wider dividend is ever formed.
+
+namespace avr_fast_div_impl {
+
+uint32_t AFD_OVERLOAD_ATTRIBUTE(FIXED) divide_fixed(uint16_t udividend, uint8_t udivisor, uint8_t shift) {
+  if (shift>bit_width<uint8_t>::value) {
+    return divide_fixed(udividend, (uint16_t)udivisor, shift);
+  }
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  afd_divmod_t<uint16_t, uint8_t> result = fast_divmod(udividend, udivisor);
+  return ((uint32_t)result.quot << shift) | divide_fraction(result.rem, udivisor, shift);
+}
+
+uint32_t AFD_OVERLOAD_ATTRIBUTE(FIXED) divide_fixed(uint16_t udividend, uint16_t udivisor, uint8_t shift) {
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  if (udivisor<=(uint16_t)UINT8_MAX && shift<=bit_width<uint8_t>::value) {
+    return divide_fixed(udividend, (uint8_t)udivisor, shift);
+  }
+  if (udividend<udivisor) {
+    // Pure fraction: no integer part
+    return divide_fraction(udividend, udivisor, shift);
+  }
+  afd_divmod_t<uint16_t, uint16_t> result = fast_divmod(udividend, udivisor);
+  return ((uint32_t)result.quot << shift) | divide_fraction(result.rem, udivisor, shift);
+}
+
+uint64_t AFD_OVERLOAD_ATTRIBUTE(FIXED) divide_fixed(uint32_t udividend, uint8_t udivisor, uint8_t shift) {
+  return divide_fixed(udividend, (uint16_t)udivisor, shift);
+}
+
+uint64_t AFD_OVERLOAD_ATTRIBUTE(FIXED) divide_fixed(uint32_t udividend, uint16_t udivisor, uint8_t shift) {
+  if (shift>bit_width<uint16_t>::value) {
+    return divide_fixed(udividend, (uint32_t)udivisor, shift);
+  }
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  if (udividend<udivisor) {
+    return divide_fraction((uint16_t)udividend, udivisor, shift);
+  }
+  afd_divmod_t<uint32_t, uint16_t> result = fast_divmodu32u16(udividend, udivisor AFD_PROFILE_ARG(AFD_PROFILE_INTERNAL));
+  return ((uint64_t)result.quot << shift) | divide_fraction(result.rem, udivisor, shift);
+}
+
+uint64_t AFD_OVERLOAD_ATTRIBUTE(FIXED) divide_fixed(uint32_t udividend, uint32_t udivisor, uint8_t shift) {
+  AFD_ZERO_DIVISOR_CHECK(udividend, udivisor);
+  if (udivisor<=(uint32_t)UINT16_MAX && shift<=bit_width<uint16_t>::value) {
+    return divide_fixed(udividend, (uint16_t)udivisor, shift);
+  }
+  if (udividend<udivisor) {
+    // Pure fraction: no integer part
+    return divide_fraction(udividend, udivisor, shift);
+  }
+  afd_divmod_t<uint32_t, uint32_t> result = fast_divmod(udividend, udivisor);
+  return ((uint64_t)result.quot << shift) | divide_fraction(result.rem, udivisor, shift);
+}
+
+}
+
 #endif
\ No newline at end of file
@@ -24,15 +24,58 @@
 /// Other compilers will see a standard div operator.
 /// @{
     
+/// @brief The result of a combined division & modulus operation. See fast_divmod()
+///
+/// @tparam TQuotient Quotient type
+/// @tparam TRemainder Remainder type
+template <typename TQuotient, typename TRemainder>
+struct afd_divmod_t {
+  TQuotient quot;   ///< Quotient: dividend/divisor
+  TRemainder rem;   ///< Remainder: dividend%divisor
+};
+
+/// @brief Preprocessor flags selecting the division backend: the code behind the
+/// division kernels. If none is set externally, one is picked from the target:
+///
+///  * AFD_BACKEND_AVR: inline AVR assembly.
+///  * AFD_BACKEND_ARMV6M: Cortex-M0/M0+ (no hardware divide). Thumb restoring 
+///    division loops for the narrow result kernels, the division operator for the rest.
+///  * AFD_BACKEND_RP2040: the RP2040 SIO hardware divider for the narrow result &
+///    large divisor kernels, the division operator for the rest.
+///  * AFD_BACKEND_C_MODEL: set by AFD_C_MODEL. The inline assembly is replaced with an
+///    equivalent C model, so the optimized algorithms build & run on any platform. 
+///    This is for verification only - it is slower than the native division.
+///
+/// Other targets have no backend: they use the division operator.
+#if !defined(AFD_BACKEND_AVR) && !defined(AFD_BACKEND_ARMV6M) && !defined(AFD_BACKEND_RP2040) && !defined(AFD_BACKEND_C_MODEL)
+#if defined(AFD_C_MODEL)
+#define AFD_BACKEND_C_MODEL
+#elif defined(__AVR__)
+#define AFD_BACKEND_AVR
+#elif defined(ARDUINO_ARCH_RP2040) || defined(PICO_RP2040)
+#define AFD_BACKEND_RP2040
+#elif defined(__ARM_ARCH_6M__)
+#define AFD_BACKEND_ARMV6M
+#endif
+#endif
+
 /// @brief Preprocessor flag to turn on optimized division.
-/// If not set eternally, will be automatically set on AVR platform.
+/// If not set eternally, will be automatically set when there is a backend.
 #if !defined(USE_OPTIMIZED_DIV)
-#if defined(__AVR__) || defined(DOXYGEN_DOCUMENTATION_BUILD)
+#if defined(AFD_BACKEND_AVR) || defined(AFD_BACKEND_ARMV6M) || defined(AFD_BACKEND_RP2040) || defined(AFD_BACKEND_C_MODEL) \
+ || defined(DOXYGEN_DOCUMENTATION_BUILD)
 #define USE_OPTIMIZED_DIV
 #endif
 #endif
 
-#if defined(USE_OPTIMIZED_DIV)
+/// @brief Preprocessor flag indicating compiler support for the 24-bit integer types (__uint24, __int24).
+/// avr-gcc supports these natively.
+#if !defined(AFD_HAS_INT24)
+#if defined(__UINT24_MAX__) && defined(__INT24_MAX__)
+#define AFD_HAS_INT24
+#endif
+#endif
+
 #include "type_traits.h"
 
 namespace avr_fast_div_impl {
@@ -56,8 +99,18 @@ static inline TUnsigned safe_abs(TSigned svalue) {
   return (TUnsigned)(svalue < 0 ? -((TUnsigned)svalue) : ((TUnsigned)svalue));
 }
 
+/// @brief Maps a fixed point dividend type to the result type of fast_div_fixed()
+template <typename TDividend>
+struct fixed_traits;
+template <> struct fixed_traits<uint16_t> { typedef uint32_t result_t; };
+template <> struct fixed_traits<uint32_t> { typedef uint64_t result_t; };
+template <> struct fixed_traits<int16_t>  { typedef int32_t  result_t; };
+template <> struct fixed_traits<int32_t>  { typedef int64_t  result_t; };
+
 }
 
+#if defined(USE_OPTIMIZED_DIV)
+
 // Public API
 
 /// @brief Optimized division of a 16-bit unsigned by a 8-bit unsigned with an *8-bit unsigned result*
@@ -78,6 +131,40 @@ uint8_t fast_div16_8(uint16_t udividend, uint8_t udivisor);
 /// @return udividend/udivisor
 uint16_t fast_div32_16(uint32_t udividend, uint16_t udivisor);
 
+/// @brief As fast_div16_8(), but checks that the result fits into 8-bits
+///
+/// This costs a single comparison.
+///
+/// @param udividend Dividend
+/// @param udivisor Divisor
+/// @param uresult Receives udividend/udivisor. UINT8_MAX if that doesn't fit into 8-bits, 0 if udivisor is 0
+/// @return true if the result fits (and the divisor is non-zero), false otherwise
+bool fast_div16_8_checked(uint16_t udividend, uint8_t udivisor, uint8_t &uresult);
+
+/// @brief As fast_div16_8(), but saturates: returns UINT8_MAX if the result doesn't fit into 8-bits
+///
+/// @param udividend Dividend
+/// @param udivisor Divisor
+/// @return min(udividend/udivisor, UINT8_MAX)
+uint8_t fast_div16_8_sat(uint16_t udividend, uint8_t udivisor);
+
+/// @brief As fast_div32_16(), but checks that the result fits into 16-bits
+///
+/// This costs a single comparison.
+///
+/// @param udividend Dividend
+/// @param udivisor Divisor
+/// @param uresult Receives udividend/udivisor. UINT16_MAX if that doesn't fit into 16-bits, 0 if udivisor is 0
+/// @return true if the result fits (and the divisor is non-zero), false otherwise
+bool fast_div32_16_checked(uint32_t udividend, uint16_t udivisor, uint16_t &uresult);
+
+/// @brief As fast_div32_16(), but saturates: returns UINT16_MAX if the result doesn't fit into 16-bits
+///
+/// @param udividend Dividend
+/// @param udivisor Divisor
+/// @return min(udividend/udivisor, UINT16_MAX)
+uint16_t fast_div32_16_sat(uint32_t udividend, uint16_t udivisor);
+
 /// @defgroup group-fast-div-overloads Replacements for the division operator
 /// @{
 
@@ -88,6 +175,15 @@ uint16_t fast_div(uint16_t udividend, uint16_t udivisor);
 uint32_t fast_div(uint32_t udividend, uint8_t  udivisor);
 uint32_t fast_div(uint32_t udividend, uint16_t udivisor);
 uint32_t fast_div(uint32_t udividend, uint32_t udivisor);
+uint64_t fast_div(uint64_t udividend, uint8_t  udivisor);
+uint64_t fast_div(uint64_t udividend, uint16_t udivisor);
+uint64_t fast_div(uint64_t udividend, uint32_t udivisor);
+uint64_t fast_div(uint64_t udividend, uint64_t udivisor);
+#if defined(AFD_HAS_INT24)
+__uint24 fast_div(__uint24 udividend, uint8_t  udivisor);
+__uint24 fast_div(__uint24 udividend, uint16_t udivisor);
+__uint24 fast_div(__uint24 udividend, __uint24 udivisor);
+#endif
 
 // Overload for all signed types
 template <typename TDividend, typename TDivisor>
@@ -120,9 +216,201 @@ static inline TDividend fast_div(TDividend dividend, TDivisor divisor) {
 
 /// @}
 
+/// @defgroup group-fast-divmod-overloads Combined division & modulus
+///
+/// @brief Returns both quotient and remainder from a single division.
+///
+/// The optimized division algorithms compute the remainder as a by-product, so 
+/// this is cheaper than calling fast_div() *and* using the modulus operator.
+/// @{
+
+// Unsigned overloads
+afd_divmod_t<uint8_t,  uint8_t>  fast_divmod(uint8_t  udividend, uint8_t  udivisor);
+afd_divmod_t<uint16_t, uint8_t>  fast_divmod(uint16_t udividend, uint8_t  udivisor);
+afd_divmod_t<uint16_t, uint16_t> fast_divmod(uint16_t udividend, uint16_t udivisor);
+afd_divmod_t<uint32_t, uint8_t>  fast_divmod(uint32_t udividend, uint8_t  udivisor);
+afd_divmod_t<uint32_t, uint16_t> fast_divmod(uint32_t udividend, uint16_t udivisor);
+afd_divmod_t<uint32_t, uint32_t> fast_divmod(uint32_t udividend, uint32_t udivisor);
+
+// Overload for all signed types. 
+// Follows C++ semantics: the quotient is truncated toward zero and the remainder
+// has the sign of the dividend.
+template <typename TDividend, typename TDivisor>
+static inline afd_divmod_t<TDividend, TDivisor> fast_divmod(TDividend dividend, TDivisor divisor) {
+  // See fast_div()
+  static_assert(type_traits::is_signed<TDividend>::value, "TDividend must be signed");
+  static_assert(type_traits::is_signed<TDivisor>::value, "TDivisor must be signed");
+
+  // Convert to unsigned.
+  using udividend_t = type_traits::make_unsigned_t<TDividend>;
+  udividend_t udividend = avr_fast_div_impl::safe_abs(dividend);
+  using udivisor_t = type_traits::make_unsigned_t<TDivisor>;
+  udivisor_t udivisor = avr_fast_div_impl::safe_abs(divisor);
+
+  // Divide the magnitudes, then restore the signs: the quotient is negative if
+  // the signs differ, the remainder takes the dividend's sign.
+  afd_divmod_t<udividend_t, udivisor_t> uresult = fast_divmod(udividend, udivisor);
+
+  const bool isSameSign = ((dividend<0) == (divisor<0));
+  return {
+    isSameSign ? (TDividend)uresult.quot : (TDividend)-((TDividend)uresult.quot),
+    dividend<0 ? (TDivisor)-((TDivisor)uresult.rem) : (TDivisor)uresult.rem
+  };
+}
+
+/// @}
+
+/// @defgroup group-fast-mod-overloads Replacements for the modulus operator
+///
+/// @brief Optimized modulus. The result type is the divisor type, since the 
+/// remainder is always less than the divisor.
+///
+/// These route through the same optimized division algorithms as fast_div(). 
+/// When the quotient will not fit into the divisor type, the upper half of the
+/// dividend is reduced first (long division), so the narrow algorithms still apply.
+/// @{
+
+// Unsigned overloads
+uint8_t  fast_mod(uint8_t  udividend, uint8_t  udivisor);
+uint8_t  fast_mod(uint16_t udividend, uint8_t  udivisor);
+uint16_t fast_mod(uint16_t udividend, uint16_t udivisor);
+uint8_t  fast_mod(uint32_t udividend, uint8_t  udivisor);
+uint16_t fast_mod(uint32_t udividend, uint16_t udivisor);
+uint32_t fast_mod(uint32_t udividend, uint32_t udivisor);
+
+// Overload for all signed types. 
+// Follows C++ semantics: the remainder has the sign of the dividend.
+template <typename TDividend, typename TDivisor>
+static inline TDivisor fast_mod(TDividend dividend, TDivisor divisor) {
+  // See fast_div()
+  static_assert(type_traits::is_signed<TDividend>::value, "TDividend must be signed");
+  static_assert(type_traits::is_signed<TDivisor>::value, "TDivisor must be signed");
+
+  // Convert to unsigned.
+  using udividend_t = type_traits::make_unsigned_t<TDividend>;
+  udividend_t udividend = avr_fast_div_impl::safe_abs(dividend);
+  using udivisor_t = type_traits::make_unsigned_t<TDivisor>;
+  udivisor_t udivisor = avr_fast_div_impl::safe_abs(divisor);
+
+  // The remainder of the magnitudes, negated if the dividend is negative. The
+  // divisor's sign doesn't affect it.
+  udivisor_t uresult = fast_mod(udividend, udivisor);
+
+  if (dividend<0) {
+    return (TDivisor)-((TDivisor)uresult);
+  }
+  return (TDivisor)uresult;
+}
+
+/// @}
+
+/// @defgroup group-fast-div-fixed Fixed point division
+///
+/// @brief (dividend << N)/divisor, without shifting into a wider type first.
+///
+/// E.g. Q8.8/Q8.8: ```fast_div_fixed<8>(a, b)``` instead of ```fast_div((uint32_t)a << 8, b)```
+///
+/// The integer part of the quotient is dividend/divisor. The N fractional bits are
+/// generated by running N more steps of the division algorithm on the remainder.
+/// So a pure fraction (dividend<divisor) costs only N division steps.
+/// @{
+
+namespace avr_fast_div_impl {
+
+// Run time shift versions: call fast_div_fixed() instead
+uint32_t divide_fixed(uint16_t udividend, uint8_t  udivisor, uint8_t shift);
+uint32_t divide_fixed(uint16_t udividend, uint16_t udivisor, uint8_t shift);
+uint64_t divide_fixed(uint32_t udividend, uint8_t  udivisor, uint8_t shift);
+uint64_t divide_fixed(uint32_t udividend, uint16_t udivisor, uint8_t shift);
+uint64_t divide_fixed(uint32_t udividend, uint32_t udivisor, uint8_t shift);
+
+template <uint8_t N, typename TDividend, typename TDivisor>
+static inline typename fixed_traits<TDividend>::result_t fast_div_fixed(TDividend udividend, TDivisor udivisor, const type_traits::false_type&) {
+  return divide_fixed(udividend, udivisor, N);
+}
+
+template <uint8_t N, typename TDividend, typename TDivisor>
+static inline typename fixed_traits<TDividend>::result_t fast_div_fixed(TDividend dividend, TDivisor divisor, const type_traits::true_type&) {
+  // See fast_div()
+  static_assert(type_traits::is_signed<TDivisor>::value, "TDivisor must be signed");
+  static_assert(N<sizeof(TDividend)*CHAR_BIT, "N must be less than the dividend width");
+
+  using result_t = typename fixed_traits<TDividend>::result_t;
+  auto uresult = divide_fixed(safe_abs(dividend), safe_abs(divisor), N);
+  const bool isSameSign = ((dividend<0) == (divisor<0));
+  return isSameSign ? (result_t)uresult : (result_t)-((result_t)uresult);
+}
+
+}
+
+/// @brief Fixed point division: (dividend << N)/divisor
+///
+/// @tparam N Number of fractional bits added to the quotient. No more than the dividend width
+/// @param dividend The dividend (numerator): a 16 or 32-bit integer
+/// @param divisor The divisor (denominator): no wider than the dividend, same signedness
+/// @return (dividend << N)/divisor, in the next wider type
+template <uint8_t N, typename TDividend, typename TDivisor>
+static inline typename avr_fast_div_impl::fixed_traits<TDividend>::result_t fast_div_fixed(TDividend dividend, TDivisor divisor) {
+  static_assert(N<=sizeof(TDividend)*CHAR_BIT, "N must be no more than the dividend width");
+  static_assert(sizeof(TDivisor)<=sizeof(TDividend), "TDivisor must be no wider than TDividend");
+  return avr_fast_div_impl::fast_div_fixed<N>(dividend, divisor, type_traits::is_signed<TDividend>());
+}
+
+/// @}
+
+/// @defgroup group-fast-muldiv-overloads Fused multiply & divide
+///
+/// @brief a*b/c, without promoting to a 32-bit multiply followed by a 32-bit division.
+///
+/// The full width product is computed with the hardware multiplier and, when the
+/// quotient fits into 16-bits, divided using the narrow algorithms. 
+/// fast_muldiv() truncates the quotient to 16-bits, the same as 
+/// ```(uint16_t)((uint32_t)a*b/c)```. fast_muldiv_sat() returns UINT16_MAX instead.
+/// @{
+
+/// @brief a*b/udivisor, truncated to 16-bits
+///
+/// @param a Multiplicand
+/// @param b Multiplier
+/// @param udivisor The divisor (denominator)
+/// @return The low 16-bits of a*b/udivisor. I.e. the quotient modulo 2^16: if it
+/// doesn't fit into 16-bits (a*b >= udivisor*65536), the result wraps. Use
+/// fast_muldiv_sat() to detect that.
+uint16_t fast_muldiv(uint16_t a, uint16_t b, uint16_t udivisor);
+/// @brief As fast_muldiv(uint16_t, uint16_t, uint16_t), for an 8-bit multiplier & divisor.
+/// The quotient also wraps modulo 2^16 if it doesn't fit.
+uint16_t fast_muldiv(uint16_t a, uint8_t  b, uint8_t  udivisor);
+/// @brief a*b/udivisor, saturated to 16-bits
+///
+/// @param a Multiplicand
+/// @param b Multiplier
+/// @param udivisor The divisor (denominator)
+/// @return a*b/udivisor, or UINT16_MAX if the quotient doesn't fit into 16-bits
+uint16_t fast_muldiv_sat(uint16_t a, uint16_t b, uint16_t udivisor);
+/// @brief As fast_muldiv_sat(uint16_t, uint16_t, uint16_t), for an 8-bit multiplier & divisor
+uint16_t fast_muldiv_sat(uint16_t a, uint8_t  b, uint8_t  udivisor);
+
+/// @}
+
+/// @brief Constant time division of a 32-bit unsigned by a 32-bit unsigned.
+///
+/// For interrupt handlers that need predictable latency more than the best 
+/// average: fast_div() picks a path based on the operands, so its execution
+/// time varies. fast_div_ct() always runs the same instructions, so takes the
+/// same number of cycles for any non-zero divisor. That is still fewer cycles
+/// than the compiler's own worst case.
+///
+/// @note A zero divisor is handled by AFD_ZERO_DIVISOR_CHECK, so takes a
+/// different (shorter) path.
+///
+/// @param udividend The dividend (numerator)
+/// @param udivisor The divisor (denominator)
+/// @return udividend/udivisor
+uint32_t fast_div_ct(uint32_t udividend, uint32_t udivisor);
+
 #else
 
-// Non-AVR platforms just fallback to standard div operator
+// Platforms without a backend just fallback to standard div operator
 template <typename TDividend, typename TDivisor>
 static inline TDividend fast_div(TDividend dividend, TDivisor divisor) {
   return dividend / divisor;
@@ -133,6 +421,203 @@ static inline uint8_t fast_div16_8(uint16_t udividend, uint8_t udivisor) {
 static inline uint16_t fast_div32_16(uint32_t udividend, uint16_t udivisor) {
   return (uint16_t)(udividend / udivisor);
 }
+static inline bool fast_div16_8_checked(uint16_t udividend, uint8_t udivisor, uint8_t &uresult) {
+  const uint16_t result = (uint16_t)(udividend / udivisor);
+  uresult = result > UINT8_MAX ? (uint8_t)UINT8_MAX : (uint8_t)result;
+  return result <= UINT8_MAX;
+}
+static inline uint8_t fast_div16_8_sat(uint16_t udividend, uint8_t udivisor) {
+  uint8_t uresult;
+  (void)fast_div16_8_checked(udividend, udivisor, uresult);
+  return uresult;
+}
+static inline bool fast_div32_16_checked(uint32_t udividend, uint16_t udivisor, uint16_t &uresult) {
+  const uint32_t result = udividend / udivisor;
+  uresult = result > UINT16_MAX ? (uint16_t)UINT16_MAX : (uint16_t)result;
+  return result <= UINT16_MAX;
+}
+static inline uint16_t fast_div32_16_sat(uint32_t udividend, uint16_t udivisor) {
+  uint16_t uresult;
+  (void)fast_div32_16_checked(udividend, udivisor, uresult);
+  return uresult;
+}
+template <typename TDividend, typename TDivisor>
+static inline afd_divmod_t<TDividend, TDivisor> fast_divmod(TDividend dividend, TDivisor divisor) {
+  return { (TDividend)(dividend / divisor), (TDivisor)(dividend % divisor) };
+}
+template <typename TDividend, typename TDivisor>
+static inline TDivisor fast_mod(TDividend dividend, TDivisor divisor) {
+  return (TDivisor)(dividend % divisor);
+}
+template <uint8_t N, typename TDividend, typename TDivisor>
+static inline typename avr_fast_div_impl::fixed_traits<TDividend>::result_t fast_div_fixed(TDividend dividend, TDivisor divisor) {
+  using result_t = typename avr_fast_div_impl::fixed_traits<TDividend>::result_t;
+  // Multiply rather than shift: left shifting a negative value is undefined
+  return (result_t)((result_t)dividend * ((result_t)1 << N)) / divisor;
+}
+static inline uint16_t fast_muldiv(uint16_t a, uint16_t b, uint16_t udivisor) {
+  return (uint16_t)(((uint32_t)a * b) / udivisor);
+}
+static inline uint16_t fast_muldiv(uint16_t a, uint8_t b, uint8_t udivisor) {
+  return (uint16_t)(((uint32_t)a * b) / udivisor);
+}
+static inline uint16_t fast_muldiv_sat(uint16_t a, uint16_t b, uint16_t udivisor) {
+  const uint32_t result = ((uint32_t)a * b) / udivisor;
+  return result > UINT16_MAX ? (uint16_t)UINT16_MAX : (uint16_t)result;
+}
+static inline uint16_t fast_muldiv_sat(uint16_t a, uint8_t b, uint8_t udivisor) {
+  return fast_muldiv_sat(a, (uint16_t)b, (uint16_t)udivisor);
+}
+static inline uint32_t fast_div_ct(uint32_t udividend, uint32_t udivisor) {
+  return udividend / udivisor;
+}
 
 #endif
+
+/// @defgroup group-fast-div-rounding Rounding division
+///
+/// @brief Division that rounds the quotient up, or to nearest, instead of truncating.
+///
+/// The correction is applied from the remainder returned by fast_divmod(), so these
+/// follow the same optimized routing and never overflow the way ```(a + b/2) / b```
+/// or ```(a + b - 1) / b``` can.
+/// @{
+
+namespace avr_fast_div_impl {
+
+// Unsigned: round up if there is any remainder
+template <typename TDividend, typename TDivisor>
+static inline TDividend divide_ceil(TDividend udividend, TDivisor udivisor, const type_traits::false_type&) {
+  afd_divmod_t<TDividend, TDivisor> result = fast_divmod(udividend, udivisor);
+  return result.rem!=0U ? (TDividend)(result.quot+1U) : result.quot;
+}
+
+// Signed: truncation already rounds up if the quotient is negative
+template <typename TDividend, typename TDivisor>
+static inline TDividend divide_ceil(TDividend dividend, TDivisor divisor, const type_traits::true_type&) {
+  afd_divmod_t<TDividend, TDivisor> result = fast_divmod(dividend, divisor);
+  const bool isSameSign = ((dividend<0) == (divisor<0));
+  return (result.rem!=0 && isSameSign) ? (TDividend)(result.quot+1) : result.quot;
+}
+
+// Unsigned: round up if rem>=divisor/2. Since rem<divisor, divisor-rem cannot overflow
+template <typename TDividend, typename TDivisor>
+static inline TDividend divide_round(TDividend udividend, TDivisor udivisor, const type_traits::false_type&) {
+  afd_divmod_t<TDividend, TDivisor> result = fast_divmod(udividend, udivisor);
+  return (result.rem!=0U && result.rem>=(TDivisor)(udivisor-result.rem)) ? (TDividend)(result.quot+1U) : result.quot;
+}
+
+// Signed: round half away from zero
+template <typename TDividend, typename TDivisor>
+static inline TDividend divide_round(TDividend dividend, TDivisor divisor, const type_traits::true_type&) {
+  afd_divmod_t<TDividend, TDivisor> result = fast_divmod(dividend, divisor);
+  using udivisor_t = type_traits::make_unsigned_t<TDivisor>;
+  const udivisor_t urem = safe_abs(result.rem);
+  if (urem!=0U && urem>=(udivisor_t)(safe_abs(divisor)-urem)) {
+    const bool isSameSign = ((dividend<0) == (divisor<0));
+    return isSameSign ? (TDividend)(result.quot+1) : (TDividend)(result.quot-1);
+  }
+  return result.quot;
+}
+
+}
+
+/// @brief Division, rounding the quotient up (towards positive infinity). I.e. ceil(dividend/divisor)
+///
+/// @param dividend The dividend (numerator)
+/// @param divisor The divisor (denominator)
+/// @return ceil(dividend/divisor)
+template <typename TDividend, typename TDivisor>
+static inline TDividend fast_div_ceil(TDividend dividend, TDivisor divisor) {
+  return avr_fast_div_impl::divide_ceil(dividend, divisor, type_traits::is_signed<TDividend>());
+}
+
+/// @brief Division, rounding the quotient to nearest (halves away from zero)
+///
+/// @param dividend The dividend (numerator)
+/// @param divisor The divisor (denominator)
+/// @return round(dividend/divisor)
+template <typename TDividend, typename TDivisor>
+static inline TDividend fast_div_round(TDividend dividend, TDivisor divisor) {
+  return avr_fast_div_impl::divide_round(dividend, divisor, type_traits::is_signed<TDividend>());
+}
+
+/// @}
+
+/// @defgroup group-fast-div-mixed Mixed signedness division
+///
+/// @brief Division where exactly one of the dividend & divisor is signed. E.g. the
+/// average of signed deltas: ```fast_div_mixed(sumOfDeltas, count)```
+///
+/// fast_div() rejects mixed signedness, since C's promotion rules convert the
+/// signed side to unsigned (E.g. ```-10/2U``` is 2147483643 on a 32-bit int platform).
+/// Casting both sides to a wider signed type is correct, but forces the slow 
+/// wide division. fast_div_mixed() instead divides the magnitudes using the 
+/// narrow unsigned overloads, then restores the sign: the result is the 
+/// mathematical quotient, truncated towards zero.
+/// @{
+
+namespace avr_fast_div_impl {
+
+// The magnitude of a value, as the unsigned type
+template <typename T>
+static inline type_traits::make_unsigned_t<T> magnitude(T value, const type_traits::true_type&) {
+  return safe_abs(value);
+}
+template <typename T>
+static inline T magnitude(T value, const type_traits::false_type&) {
+  return value;
+}
+
+template <typename T>
+static inline bool is_negative(T value, const type_traits::true_type&) {
+  return value<0;
+}
+template <typename T>
+static inline bool is_negative(T, const type_traits::false_type&) {
+  return false;
+}
+
+/// @brief Maps the dividend type of fast_div_mixed() to the result type
+template <typename TDividend, bool isSigned = type_traits::is_signed<TDividend>::value>
+struct mixed_traits;
+// A signed dividend: |quotient|<=|dividend|, so the dividend type holds any result
+template <typename TDividend>
+struct mixed_traits<TDividend, true> { typedef TDividend result_t; };
+// An unsigned dividend: the quotient can be -dividend, so the next wider signed type is needed
+template <> struct mixed_traits<uint8_t, false>  { typedef int16_t result_t; };
+template <> struct mixed_traits<uint16_t, false> { typedef int32_t result_t; };
+template <> struct mixed_traits<uint32_t, false> { typedef int64_t result_t; };
+
+}
+
+/// @brief Division of mixed signedness operands, with mathematical (not C promotion) semantics
+///
+/// @note For an unsigned dividend, the result is the next wider signed type. 
+/// E.g. fast_div_mixed(uint16_t, int8_t) returns an int32_t
+///
+/// @param dividend The dividend (numerator)
+/// @param divisor The divisor (denominator). Opposite signedness to the dividend
+/// @return dividend/divisor, truncated towards zero
+template <typename TDividend, typename TDivisor>
+static inline typename avr_fast_div_impl::mixed_traits<TDividend>::result_t fast_div_mixed(TDividend dividend, TDivisor divisor) {
+  static_assert(type_traits::is_signed<TDividend>::value!=type_traits::is_signed<TDivisor>::value, "Use fast_div() when the signedness matches");
+  using result_t = typename avr_fast_div_impl::mixed_traits<TDividend>::result_t;
+
+  // Divide the magnitudes of both operands: the unsigned side is used as is, the
+  // signed side via safe_abs(). The quotient is at most the dividend's magnitude.
+  // mixed_traits picks a result type wide enough to hold it negated.
+  const type_traits::make_unsigned_t<TDividend> uresult = 
+      fast_div(avr_fast_div_impl::magnitude(dividend, type_traits::is_signed<TDividend>()), 
+               avr_fast_div_impl::magnitude(divisor, type_traits::is_signed<TDivisor>()));
+
+  // Only one side is signed, so the quotient is negative if that side is
+  const bool isNegative = avr_fast_div_impl::is_negative(dividend, type_traits::is_signed<TDividend>())
+                       || avr_fast_div_impl::is_negative(divisor, type_traits::is_signed<TDivisor>());
+  // Negate as unsigned: -(INT_MIN) overflows
+  using uresult_t = type_traits::make_unsigned_t<result_t>;
+  return isNegative ? (result_t)(uresult_t)((uresult_t)0U - (uresult_t)uresult) : (result_t)uresult;
+}
+
+/// @}
 /// @}
\ No newline at end of file
@@ -49,6 +49,11 @@ namespace type_traits {
   template<>
     struct is_unsigned<uint64_t> : public true_type { };
 
+#if defined(__UINT24_MAX__)
+  template<>
+    struct is_unsigned<__uint24> : public true_type { };
+#endif
+
   template<typename _Tp>
     struct is_signed : public __not__<is_unsigned<_Tp>> { };
 
@@ -68,6 +73,52 @@ namespace type_traits {
   template<>
     struct make_unsigned<int64_t> { typedef uint64_t type; };
 
+#if defined(__INT24_MAX__)
+  template<>
+    struct make_unsigned<__int24> { typedef __uint24 type; };
+#endif
+
   template<typename _Tp>
     using make_unsigned_t = typename make_unsigned<_Tp>::type;
+
+  // Limited replacement for std::make_signed 
+  template<typename _Tp>
+    struct make_signed { typedef _Tp type; };
+  
+  template<> 
+    struct make_signed<uint8_t> { typedef int8_t type; };
+
+  template<>
+    struct make_signed<uint16_t> { typedef int16_t type; };
+
+  template<>
+    struct make_signed<uint32_t> { typedef int32_t type; };
+
+  template<>
+    struct make_signed<uint64_t> { typedef int64_t type; };
+
+#if defined(__UINT24_MAX__)
+  template<>
+    struct make_signed<__uint24> { typedef __int24 type; };
+#endif
+
+  template<typename _Tp>
+    using make_signed_t = typename make_signed<_Tp>::type;
+
+  // Replacement for std::conditional
+  template<bool _Cond, typename _Iftrue, typename _Iffalse>
+    struct conditional { typedef _Iftrue type; };
+
+  template<typename _Iftrue, typename _Iffalse>
+    struct conditional<false, _Iftrue, _Iffalse> { typedef _Iffalse type; };
+
+  template<bool _Cond, typename _Iftrue, typename _Iffalse>
+    using conditional_t = typename conditional<_Cond, _Iftrue, _Iffalse>::type;
+
+  // Replacement for std::is_same
+  template<typename _Tp, typename _Up>
+    struct is_same : public false_type { };
+
+  template<typename _Tp>
+    struct is_same<_Tp, _Tp> : public true_type { };
 }
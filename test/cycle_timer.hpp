@@ -0,0 +1,99 @@
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__AVR__)
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#endif
+
+// Claims Timer1 as a free running CPU cycle counter (normal mode, prescaler 1) with
+// interrupts masked, for the lifetime of the object. The previous Timer1 setup &
+// interrupt state are restored on destruction.
+//
+// Masking interrupts keeps the Timer0 (millis) ISR out of the measurements. Only
+// micros()/millis() accuracy is affected while the scope is alive.
+class cycle_counter_scope_t {
+#if defined(__AVR__)
+private:
+    uint8_t sreg;
+    uint8_t tccr1a;
+    uint8_t tccr1b;
+
+public:
+    cycle_counter_scope_t()
+        : sreg(SREG)
+    {
+        cli();
+        tccr1a = TCCR1A;
+        tccr1b = TCCR1B;
+        TCCR1A = 0U;
+        TCCR1B = _BV(CS10);
+    }
+
+    ~cycle_counter_scope_t() {
+        TCCR1B = tccr1b;
+        TCCR1A = tccr1a;
+        SREG = sreg;
+    }
+#endif
+};
+
+// Accumulates CPU cycles across many start()/stop() intervals.
+//
+// Unlike simple_timer_t, this isn't limited by the 4us resolution of micros().
+// Timer1 is 16-bit, so each interval must be shorter than 65536 cycles: time each
+// call individually rather than a whole loop.
+//
+// Requires an active cycle_counter_scope_t. On non-AVR platforms, only the
+// intervals are counted: the cycle count is always zero.
+class cycle_timer_t {
+private:
+    uint32_t total_cycles = 0U;
+    uint32_t intervals = 0U;
+#if defined(__AVR__)
+    uint16_t start_count = 0U;
+    uint16_t overhead = 0U;
+#endif
+
+public:
+
+    // Clear the accumulated count & calibrate out the cost of start()/stop()
+    void reset() {
+#if defined(__AVR__)
+        overhead = 0U;
+        total_cycles = 0U;
+        start();
+        stop();
+        overhead = (uint16_t)total_cycles;
+#endif
+        total_cycles = 0U;
+        intervals = 0U;
+    }
+
+    inline void start() __attribute__((always_inline)) {
+#if defined(__AVR__)
+        start_count = TCNT1;
+#endif
+    }
+
+    inline void stop() __attribute__((always_inline)) {
+#if defined(__AVR__)
+        const uint16_t end_count = TCNT1;
+        total_cycles += (uint16_t)(end_count - start_count - overhead);
+#endif
+        ++intervals;
+    }
+
+    uint32_t duration_cycles() const {
+        return total_cycles;
+    }
+
+    uint32_t num_intervals() const {
+        return intervals;
+    }
+
+    uint32_t cycles_per_interval() const {
+        return intervals==0U ? 0U : total_cycles / intervals;
+    }
+};
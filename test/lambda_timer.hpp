@@ -1,6 +1,7 @@
 #pragma once
 
 #include "timer.hpp"
+#include "cycle_timer.hpp"
 
 template <typename TLoop, typename TParam>
 void measure_executiontime(uint16_t iterations, TLoop from, TLoop to, TLoop step, simple_timer_t &measure, TParam param, void (*pTestFun)(TLoop, TParam)) {
@@ -15,10 +16,25 @@ void measure_executiontime(uint16_t iterations, TLoop from, TLoop to, TLoop step
     measure.stop();
 }
 
+// Time each call individually, in CPU cycles. Since this is cycle accurate, a
+// single pass over the range is enough.
+template <typename TLoop, typename TParam>
+void measure_executioncycles(TLoop from, TLoop to, TLoop step, cycle_timer_t &measure, TParam param, void (*pTestFun)(TLoop, TParam)) {
+    cycle_counter_scope_t counterScope;
+    measure.reset();
+    for (TLoop a = from; a < to; a = (TLoop)(a + step))
+    {
+      measure.start();
+      pTestFun(a, param);
+      measure.stop();
+    }
+}
+
 template <typename TParam>
 struct execution_time {
     TParam result;
     simple_timer_t timer;
+    cycle_timer_t cycles;
 };
 
 template <typename TParam>
@@ -39,9 +55,17 @@ comparative_execution_times<TParam> compare_executiontime(uint16_t iterations, T
     TParam paramB = 0;
     measure_executiontime<TLoop, TParam&>(iterations, from, to, step, timerB, paramB, pTestFunB);
 
+    cycle_timer_t cyclesA;
+    TParam cycleParamA = 0;
+    measure_executioncycles<TLoop, TParam&>(from, to, step, cyclesA, cycleParamA, pTestFunA);
+
+    cycle_timer_t cyclesB;
+    TParam cycleParamB = 0;
+    measure_executioncycles<TLoop, TParam&>(from, to, step, cyclesB, cycleParamB, pTestFunB);
+
     return comparative_execution_times<TParam> {
-        .timeA = execution_time<TParam> { .result = paramA, .timer = timerA },
-        .timeB = execution_time<TParam> { .result = paramB, .timer = timerB }
+        .timeA = execution_time<TParam> { .result = paramA, .timer = timerA, .cycles = cyclesA },
+        .timeB = execution_time<TParam> { .result = paramB, .timer = timerB, .cycles = cyclesB }
     };
 }
 
@@ -4,6 +4,14 @@
 
 extern void test_implementation_details(void);
 extern void test_fast_div(void);
+extern void test_afd_divisor(void);
+extern void test_afd_array(void);
+extern void test_afd_profile(void);
+extern void test_afd_range(void);
+extern void test_afd_isr(void);
+extern void test_afd_interpolate(void);
+extern void test_reciprocal_table(void);
+extern void test_newton_raphson(void);
 
 void setup()
 {
@@ -28,6 +36,14 @@ void setup()
     Serial.println("Testing Public API");
     Serial.println("------------------");
     test_fast_div();
+    test_afd_divisor();
+    test_afd_array();
+    test_afd_profile();
+    test_afd_range();
+    test_afd_isr();
+    test_afd_interpolate();
+    test_reciprocal_table();
+    test_newton_raphson();
     UNITY_END(); 
     
     // Tell SimAVR we are done
@@ -0,0 +1,106 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "afd_array.h"
+
+template <typename T, size_t N>
+static constexpr size_t array_size(const T (&)[N]) {
+  return N;
+}
+
+// Wrap up the assertion that fast_div_array(a, b) == [ fast_div(a[0], b), ... ]
+template <typename TDividend, typename TDivisor, size_t N>
+static void assert_fast_div_array(const TDividend (&dividends)[N], TDivisor divisor) {
+  TDividend results[N];
+  fast_div_array(dividends, divisor, results, N);
+
+  char msgBuffer[256];
+  for (size_t index=0; index<N; ++index) {
+    sprintf(msgBuffer, "%s: %" PRId32 ", %" PRId32, __PRETTY_FUNCTION__, (int32_t)dividends[index], (int32_t)divisor);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(fast_div(dividends[index], divisor), results[index], msgBuffer);
+  }
+}
+
+// Wrap up the assertion that fast_div_array(a, b) == [ fast_div(a[0], b[0]), ... ]
+template <typename TDividend, typename TDivisor, size_t N>
+static void assert_fast_div_array(const TDividend (&dividends)[N], const TDivisor (&divisors)[N]) {
+  TDividend results[N];
+  fast_div_array(dividends, divisors, results, N);
+
+  char msgBuffer[256];
+  for (size_t index=0; index<N; ++index) {
+    sprintf(msgBuffer, "%s: %" PRId32 ", %" PRId32, __PRETTY_FUNCTION__, (int32_t)dividends[index], (int32_t)divisors[index]);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(fast_div(dividends[index], divisors[index]), results[index], msgBuffer);
+  }
+}
+
+static void test_fast_div_array_scalar_unsigned(void) {
+  static const uint16_t dividends16[] = { 0U, 1U, 254U, 255U, 256U, 1023U, 4095U, UINT16_MAX-1U, UINT16_MAX };
+  assert_fast_div_array(dividends16, (uint8_t)1U);
+  assert_fast_div_array(dividends16, (uint8_t)3U);
+  assert_fast_div_array(dividends16, (uint8_t)UINT8_MAX);
+  assert_fast_div_array(dividends16, (uint16_t)1000U);
+  assert_fast_div_array(dividends16, (uint16_t)UINT16_MAX);
+
+  static const uint32_t dividends32[] = { 0U, 1U, UINT16_MAX, UINT16_MAX+1UL, 60000000UL, UINT32_MAX/3U, UINT32_MAX-1U, UINT32_MAX };
+  assert_fast_div_array(dividends32, (uint8_t)7U);
+  assert_fast_div_array(dividends32, (uint16_t)6000U);
+  assert_fast_div_array(dividends32, (uint32_t)(UINT16_MAX+3UL));
+  assert_fast_div_array(dividends32, (uint32_t)UINT32_MAX);
+}
+
+static void test_fast_div_array_scalar_signed(void) {
+  static const int16_t dividends16[] = { INT16_MIN, INT16_MIN+1, -1000, -1, 0, 1, 1000, INT16_MAX };
+  assert_fast_div_array(dividends16, (int8_t)3);
+  assert_fast_div_array(dividends16, (int8_t)-7);
+  assert_fast_div_array(dividends16, (int16_t)INT16_MIN);
+
+  static const int32_t dividends32[] = { INT32_MIN, INT32_MIN+1, -60000000L, -1, 0, 1, 60000000L, INT32_MAX };
+  assert_fast_div_array(dividends32, (int8_t)-3);
+  assert_fast_div_array(dividends32, (int16_t)6000);
+  assert_fast_div_array(dividends32, (int32_t)-100000L);
+}
+
+static void test_fast_div_array_scalar_zero_divisor(void) {
+#if defined(USE_OPTIMIZED_DIV)
+  static const uint32_t dividends[] = { 0U, 1U, UINT16_MAX, UINT32_MAX };
+  uint32_t results[array_size(dividends)] = { 1U, 1U, 1U, 1U };
+  fast_div_array(dividends, (uint16_t)0U, results, array_size(dividends));
+  for (size_t index=0; index<array_size(results); ++index) {
+    TEST_ASSERT_EQUAL_UINT32(0U, results[index]);
+  }
+#endif
+}
+
+static void test_fast_div_array_in_place(void) {
+  uint16_t values[] = { 100U, 200U, 300U, UINT16_MAX };
+  fast_div_array(values, (uint8_t)10U, values, array_size(values));
+  TEST_ASSERT_EQUAL_UINT16(10U, values[0]);
+  TEST_ASSERT_EQUAL_UINT16(20U, values[1]);
+  TEST_ASSERT_EQUAL_UINT16(30U, values[2]);
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX/10U, values[3]);
+}
+
+static void test_fast_div_array_elementwise(void) {
+  static const uint16_t dividends16[] = { 0U, 1U, 255U, 256U, 4095U, UINT16_MAX };
+  static const uint8_t divisors8[] = { 1U, 3U, 2U, UINT8_MAX, 16U, 7U };
+  assert_fast_div_array(dividends16, divisors8);
+
+  static const uint32_t dividends32[] = { 0U, 1U, UINT16_MAX+1UL, 60000000UL, UINT32_MAX };
+  static const uint32_t divisors32[] = { 1U, 3U, UINT16_MAX+1UL, 6000U, UINT16_MAX+3UL };
+  assert_fast_div_array(dividends32, divisors32);
+
+  static const int32_t sdividends32[] = { INT32_MIN, -1, 0, 1, INT32_MAX };
+  static const int16_t sdivisors16[] = { -1, 3, -5, INT16_MIN, INT16_MAX };
+  assert_fast_div_array(sdividends32, sdivisors16);
+}
+
+void test_afd_array(void) {
+    SET_UNITY_FILENAME() {
+        RUN_TEST(test_fast_div_array_scalar_unsigned);
+        RUN_TEST(test_fast_div_array_scalar_signed);
+        RUN_TEST(test_fast_div_array_scalar_zero_divisor);
+        RUN_TEST(test_fast_div_array_in_place);
+        RUN_TEST(test_fast_div_array_elementwise);
+    }
+}
@@ -0,0 +1,143 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "afd_divisor.h"
+
+static constexpr uint32_t MICROS_PER_MIN = 60000000UL;
+
+// Wrap up the assertion that fast_div(a,b)==fast_div(a,afd_divisor(b))
+template <typename TDividend, typename TDivisor>
+static void assert_afd_divisor(TDividend dividend, const afd_divisor<TDivisor> &divisor) {
+  TDividend expected = 0;
+  if (divisor.divisor()!=0) { // Division by zero on Teensy generates an exception
+    expected = (TDividend)(dividend/divisor.divisor());
+  }
+  TDividend actual = fast_div(dividend, divisor);
+
+  char msgBuffer[256];
+  sprintf(msgBuffer, "%s: %" PRId32 ", %" PRId32, __PRETTY_FUNCTION__, (int32_t)dividend, (int32_t)divisor.divisor());
+  TEST_ASSERT_EQUAL_INT32_MESSAGE(expected, actual, msgBuffer);
+}
+
+// Divide a spread of dividends by one divisor
+template <typename TDividend, typename TDivisor>
+static void assert_afd_divisor_range(TDivisor divisor, TDividend dividendMin, TDividend dividendMax) {
+  const afd_divisor<TDivisor> precomputed(divisor);
+  assert_afd_divisor(dividendMin, precomputed);
+  assert_afd_divisor(dividendMax, precomputed);
+  assert_afd_divisor((TDividend)divisor, precomputed);
+  assert_afd_divisor((TDividend)(divisor-1), precomputed);
+  assert_afd_divisor((TDividend)(divisor+1), precomputed);
+  constexpr uint8_t steps = 37U;
+  using udividend_t = type_traits::make_unsigned_t<TDividend>;
+  const udividend_t step = (udividend_t)((udividend_t)(dividendMax/steps)-(udividend_t)(dividendMin/steps));
+  for (uint8_t index=0; index<steps; ++index) {
+    assert_afd_divisor((TDividend)((udividend_t)dividendMin + (udividend_t)(step*index)), precomputed);
+  }
+}
+
+static void test_afd_divisor_u16_u8(void) {
+#if defined(USE_OPTIMIZED_DIV)
+  assert_afd_divisor_range<uint16_t, uint8_t>(0U, 0U, UINT16_MAX);
+#endif
+  assert_afd_divisor_range<uint16_t, uint8_t>(1U, 0U, UINT16_MAX);
+  assert_afd_divisor_range<uint16_t, uint8_t>(7U, 0U, UINT16_MAX);
+  assert_afd_divisor_range<uint16_t, uint8_t>(64U, 0U, UINT16_MAX);
+  assert_afd_divisor_range<uint16_t, uint8_t>(UINT8_MAX, 0U, UINT16_MAX);
+}
+
+static void test_afd_divisor_u32_u16(void) {
+#if defined(USE_OPTIMIZED_DIV)
+  assert_afd_divisor_range<uint32_t, uint16_t>(0U, 0U, UINT32_MAX);
+#endif
+  assert_afd_divisor_range<uint32_t, uint16_t>(1U, 0U, UINT32_MAX);
+  assert_afd_divisor_range<uint32_t, uint16_t>(3333U, 0U, MICROS_PER_MIN);  // 18000 RPM  
+  assert_afd_divisor_range<uint32_t, uint16_t>(7715U, 0U, MICROS_PER_MIN);  // 7777 RPM  
+  assert_afd_divisor_range<uint32_t, uint16_t>(32768U, 0U, UINT32_MAX);
+  assert_afd_divisor_range<uint32_t, uint16_t>(UINT16_MAX, 0U, UINT32_MAX);
+}
+
+static void test_afd_divisor_u32_u32(void) {
+  assert_afd_divisor_range<uint32_t, uint32_t>(1U, 0U, UINT32_MAX);
+  assert_afd_divisor_range<uint32_t, uint32_t>(UINT16_MAX+1UL, 0U, UINT32_MAX);
+  assert_afd_divisor_range<uint32_t, uint32_t>(UINT32_MAX/33UL, 0U, UINT32_MAX);
+  assert_afd_divisor_range<uint32_t, uint32_t>(0x80000001UL, 0U, UINT32_MAX);
+  assert_afd_divisor_range<uint32_t, uint32_t>(UINT32_MAX, 0U, UINT32_MAX);
+}
+
+static void test_afd_divisor_signed(void) {
+  assert_afd_divisor_range<int16_t, int8_t>(-7, INT16_MIN+1, INT16_MAX);
+  assert_afd_divisor_range<int16_t, int8_t>(INT8_MIN, INT16_MIN+1, INT16_MAX);
+  assert_afd_divisor_range<int16_t, int8_t>(INT8_MAX, INT16_MIN+1, INT16_MAX);
+  assert_afd_divisor_range<int32_t, int16_t>(-3333, INT32_MIN+1, INT32_MAX);
+  assert_afd_divisor_range<int32_t, int16_t>(INT16_MIN, INT32_MIN+1, INT32_MAX);
+  assert_afd_divisor_range<int32_t, int32_t>(-INT32_MAX/33L, INT32_MIN+1, INT32_MAX);
+  assert_afd_divisor_range<int32_t, int32_t>(INT32_MAX, INT32_MIN+1, INT32_MAX);
+}
+
+// Wrap up the assertion that a/divisor==fast_div<divisor>(a)
+template <uint32_t divisor, typename TDividend>
+static void assert_constant_divisor(TDividend dividend) {
+  TDividend expected = (TDividend)(dividend/(int64_t)divisor);
+  TDividend actual = fast_div<divisor>(dividend);
+
+  char msgBuffer[256];
+  sprintf(msgBuffer, "%s: %" PRId32, __PRETTY_FUNCTION__, (int32_t)dividend);
+  TEST_ASSERT_EQUAL_INT32_MESSAGE(expected, actual, msgBuffer);
+}
+
+template <uint32_t divisor, typename TDividend>
+static void assert_constant_divisor_range(TDividend dividendMin, TDividend dividendMax) {
+  assert_constant_divisor<divisor>(dividendMin);
+  assert_constant_divisor<divisor>(dividendMax);
+  assert_constant_divisor<divisor>((TDividend)divisor);
+  assert_constant_divisor<divisor>((TDividend)(divisor-1U));
+  assert_constant_divisor<divisor>((TDividend)(divisor+1U));
+  constexpr uint8_t steps = 37U;
+  using udividend_t = type_traits::make_unsigned_t<TDividend>;
+  const udividend_t step = (udividend_t)((udividend_t)(dividendMax/steps)-(udividend_t)(dividendMin/steps));
+  for (uint8_t index=0; index<steps; ++index) {
+    assert_constant_divisor<divisor>((TDividend)((udividend_t)dividendMin + (udividend_t)(step*index)));
+  }
+}
+
+template <uint32_t divisor>
+static void assert_constant_divisor_all_types(void) {
+  assert_constant_divisor_range<divisor, uint8_t>(0U, UINT8_MAX);
+  assert_constant_divisor_range<divisor, int8_t>(INT8_MIN+1, INT8_MAX);
+  assert_constant_divisor_range<divisor, uint16_t>(0U, UINT16_MAX);
+  assert_constant_divisor_range<divisor, int16_t>(INT16_MIN+1, INT16_MAX);
+  assert_constant_divisor_range<divisor, uint32_t>(0U, UINT32_MAX);
+  assert_constant_divisor_range<divisor, int32_t>(INT32_MIN+1, INT32_MAX);
+}
+
+static void test_constant_divisor_pow2(void) {
+  assert_constant_divisor_all_types<1U>();
+  assert_constant_divisor_all_types<2U>();
+  assert_constant_divisor_all_types<128U>();
+  assert_constant_divisor_all_types<65536UL>();
+}
+
+static void test_constant_divisor_mul_high(void) {
+  assert_constant_divisor_all_types<3U>();
+  assert_constant_divisor_all_types<6U>();
+  assert_constant_divisor_all_types<7U>();
+  assert_constant_divisor_all_types<60U>();
+  assert_constant_divisor_all_types<255U>();
+  assert_constant_divisor_all_types<641U>();
+  assert_constant_divisor_all_types<7715U>();
+  assert_constant_divisor_all_types<UINT16_MAX>();
+  assert_constant_divisor_all_types<MICROS_PER_MIN>();
+  assert_constant_divisor_all_types<INT32_MAX>();
+}
+
+void test_afd_divisor(void) {
+    SET_UNITY_FILENAME() {
+        RUN_TEST(test_afd_divisor_u16_u8);
+        RUN_TEST(test_afd_divisor_u32_u16);
+        RUN_TEST(test_afd_divisor_u32_u32);
+        RUN_TEST(test_afd_divisor_signed);
+        RUN_TEST(test_constant_divisor_pow2);
+        RUN_TEST(test_constant_divisor_mul_high);
+    }
+}
@@ -0,0 +1,144 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "afd_interpolate.h"
+
+// The formula, using the division operator
+template <typename TAxis, typename TValue>
+static TValue reference_interpolate(TAxis x0, TAxis x1, TValue y0, TValue y1, TAxis x) {
+  const int64_t value = (int64_t)y0 + (((int64_t)x - x0) * ((int64_t)y1 - y0)) / ((int64_t)x1 - x0);
+  return (TValue)value;
+}
+
+template <typename TAxis>
+static uint8_t reference_bin(const TAxis *pAxis, uint8_t size, TAxis &x) {
+  x = x<pAxis[0] ? pAxis[0] : (x>pAxis[size-1U] ? pAxis[size-1U] : x);
+  uint8_t index = 0U;
+  while (index<size-2U && x>pAxis[index+1U]) {
+    ++index;
+  }
+  return index;
+}
+
+template <typename TAxis, typename TValue>
+static TValue reference_interpolate(const TAxis *pAxis, const TValue *pValues, uint8_t size, TAxis x) {
+  const uint8_t index = reference_bin(pAxis, size, x);
+  return reference_interpolate(pAxis[index], pAxis[index+1U], pValues[index], pValues[index+1U], x);
+}
+
+template <typename TAxis, typename TValue>
+static TValue reference_interpolate2d(const TAxis *pXAxis, uint8_t xSize, const TAxis *pYAxis, uint8_t ySize, const TValue *pValues, TAxis x, TAxis y) {
+  const uint8_t xIndex = reference_bin(pXAxis, xSize, x);
+  const uint8_t yIndex = reference_bin(pYAxis, ySize, y);
+  const TValue *pRow0 = pValues + (yIndex*xSize);
+  const TValue *pRow1 = pRow0 + xSize;
+  const TValue top = reference_interpolate(pXAxis[xIndex], pXAxis[xIndex+1U], pRow0[xIndex], pRow0[xIndex+1U], x);
+  const TValue bottom = reference_interpolate(pXAxis[xIndex], pXAxis[xIndex+1U], pRow1[xIndex], pRow1[xIndex+1U], x);
+  return reference_interpolate(pYAxis[yIndex], pYAxis[yIndex+1U], top, bottom, y);
+}
+
+// Sweep x across the axis (plus either side): the cached & uncached forms must match the formula
+template <typename TAxis, typename TValue>
+static void assert_interpolate(const TAxis *pAxis, const TValue *pValues, uint8_t size, TAxis xMin, TAxis xMax, TAxis xStep) {
+  afd_interp_bin<TAxis, TValue> bin;
+  for (uint32_t x=xMin; x<=xMax; x+=xStep) {
+    char msgBuffer[32];
+    sprintf(msgBuffer, "%" PRIu32, x);
+    const TValue expected = reference_interpolate(pAxis, pValues, size, (TAxis)x);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(expected, fast_interpolate(pAxis, pValues, size, (TAxis)x), msgBuffer);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(expected, fast_interpolate(pAxis, pValues, size, (TAxis)x, bin), msgBuffer);
+  }
+}
+
+static void test_fast_interpolate_u16_u8(void) {
+  static const uint16_t axis[] = { 500U, 1000U, 1500U, 2500U, 4000U, 6500U, 7000U };
+  static const uint8_t values[] = { 30U, 45U, 80U, 255U, 0U, 100U, 99U };
+  assert_interpolate(axis, values, sizeof(axis)/sizeof(axis[0]), (uint16_t)0U, (uint16_t)8000U, (uint16_t)7U);
+}
+
+static void test_fast_interpolate_u16_u16(void) {
+  static const uint16_t axis[] = { 0U, 1U, 300U, 20000U, 65535U };
+  static const uint16_t values[] = { 1000U, 0U, UINT16_MAX, 1234U, UINT16_MAX };
+  assert_interpolate(axis, values, sizeof(axis)/sizeof(axis[0]), (uint16_t)0U, (uint16_t)65000U, (uint16_t)131U);
+  assert_interpolate(axis, values, sizeof(axis)/sizeof(axis[0]), (uint16_t)65000U, (uint16_t)65535U, (uint16_t)1U);
+}
+
+static void test_fast_interpolate_u8_u8(void) {
+  static const uint8_t axis[] = { 10U, 20U, 21U, 100U, 250U };
+  static const uint8_t values[] = { 0U, 255U, 0U, 17U, 200U };
+  assert_interpolate(axis, values, sizeof(axis)/sizeof(axis[0]), (uint8_t)0U, (uint8_t)UINT8_MAX, (uint8_t)1U);
+}
+
+static void test_fast_interpolate_u8_u16(void) {
+  static const uint8_t axis[] = { 0U, 128U, 255U };
+  static const uint16_t values[] = { UINT16_MAX, 0U, 40000U };
+  assert_interpolate(axis, values, sizeof(axis)/sizeof(axis[0]), (uint8_t)0U, (uint8_t)UINT8_MAX, (uint8_t)1U);
+}
+
+static void test_fast_interpolate_bin_reuse(void) {
+  static const uint16_t axis[] = { 500U, 1000U, 1500U, 2500U };
+  static const uint16_t values[] = { 100U, 900U, 300U, 300U };
+  afd_interp_bin<uint16_t, uint16_t> bin;
+  TEST_ASSERT_EQUAL_UINT16(reference_interpolate(axis, values, 4U, (uint16_t)1200U), fast_interpolate(axis, values, 4U, (uint16_t)1200U, bin));
+  TEST_ASSERT_EQUAL_UINT8(1U, bin.index());
+  // Same bin
+  TEST_ASSERT_EQUAL_UINT16(reference_interpolate(axis, values, 4U, (uint16_t)1499U), fast_interpolate(axis, values, 4U, (uint16_t)1499U, bin));
+  TEST_ASSERT_EQUAL_UINT8(1U, bin.index());
+  // Both directions
+  TEST_ASSERT_EQUAL_UINT16(reference_interpolate(axis, values, 4U, (uint16_t)600U), fast_interpolate(axis, values, 4U, (uint16_t)600U, bin));
+  TEST_ASSERT_EQUAL_UINT8(0U, bin.index());
+  TEST_ASSERT_EQUAL_UINT16(300U, fast_interpolate(axis, values, 4U, (uint16_t)3000U, bin));
+  TEST_ASSERT_EQUAL_UINT8(2U, bin.index());
+  TEST_ASSERT_EQUAL_UINT16(100U, fast_interpolate(axis, values, 4U, (uint16_t)0U, bin));
+  TEST_ASSERT_EQUAL_UINT8(0U, bin.index());
+}
+
+template <typename TAxis, typename TValue>
+static void assert_interpolate2d(const TAxis *pXAxis, uint8_t xSize, const TAxis *pYAxis, uint8_t ySize, const TValue *pValues,
+                                 TAxis xMax, TAxis xStep, TAxis yMax, TAxis yStep) {
+  afd_interp_bin<TAxis, TValue> xBin, yBin;
+  for (uint32_t y=0U; y<=yMax; y+=yStep) {
+    for (uint32_t x=0U; x<=xMax; x+=xStep) {
+      char msgBuffer[32];
+      sprintf(msgBuffer, "%" PRIu32 ", %" PRIu32, x, y);
+      const TValue expected = reference_interpolate2d(pXAxis, xSize, pYAxis, ySize, pValues, (TAxis)x, (TAxis)y);
+      TEST_ASSERT_EQUAL_UINT16_MESSAGE(expected, fast_interpolate2d(pXAxis, xSize, pYAxis, ySize, pValues, (TAxis)x, (TAxis)y), msgBuffer);
+      TEST_ASSERT_EQUAL_UINT16_MESSAGE(expected, fast_interpolate2d(pXAxis, xSize, pYAxis, ySize, pValues, (TAxis)x, (TAxis)y, xBin, yBin), msgBuffer);
+    }
+  }
+}
+
+static void test_fast_interpolate2d_u16_u8(void) {
+  // RPM x load
+  static const uint16_t rpmAxis[] = { 500U, 1500U, 3000U, 6000U };
+  static const uint16_t loadAxis[] = { 20U, 50U, 100U };
+  static const uint8_t values[] = {
+     30U,  60U,  90U, 120U,
+     50U, 100U, 255U, 140U,
+     70U,   0U, 200U, 160U,
+  };
+  assert_interpolate2d(rpmAxis, 4U, loadAxis, 3U, values, (uint16_t)7000U, (uint16_t)97U, (uint16_t)120U, (uint16_t)3U);
+}
+
+static void test_fast_interpolate2d_u8_u16(void) {
+  static const uint8_t xAxis[] = { 0U, 100U, 255U };
+  static const uint8_t yAxis[] = { 10U, 11U, 200U };
+  static const uint16_t values[] = {
+    0U,         UINT16_MAX, 1000U,
+    UINT16_MAX, 0U,         50000U,
+    12345U,     1U,         UINT16_MAX,
+  };
+  assert_interpolate2d(xAxis, 3U, yAxis, 3U, values, (uint8_t)UINT8_MAX, (uint8_t)5U, (uint8_t)UINT8_MAX, (uint8_t)3U);
+}
+
+void test_afd_interpolate(void) {
+    SET_UNITY_FILENAME() {
+        RUN_TEST(test_fast_interpolate_u16_u8);
+        RUN_TEST(test_fast_interpolate_u16_u16);
+        RUN_TEST(test_fast_interpolate_u8_u8);
+        RUN_TEST(test_fast_interpolate_u8_u16);
+        RUN_TEST(test_fast_interpolate_bin_reuse);
+        RUN_TEST(test_fast_interpolate2d_u16_u8);
+        RUN_TEST(test_fast_interpolate2d_u8_u16);
+    }
+}
@@ -0,0 +1,126 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "afd_isr.h"
+
+// Wrap up the assertion that fast_div_isr() matches the division operator
+template <typename TDividend, typename TDivisor>
+static void assert_fast_div_isr(const TDividend *pDividends, size_t numDividends, const TDivisor *pDivisors, size_t numDivisors) {
+  for (size_t dividendIndex=0U; dividendIndex<numDividends; ++dividendIndex) {
+    for (size_t divisorIndex=0U; divisorIndex<numDivisors; ++divisorIndex) {
+      const TDividend dividend = pDividends[dividendIndex];
+      const TDivisor divisor = pDivisors[divisorIndex];
+      char msgBuffer[64];
+      sprintf(msgBuffer, "%" PRIu32 ", %" PRIu32, (uint32_t)dividend, (uint32_t)divisor);
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend/divisor, fast_div_isr(dividend, divisor), msgBuffer);
+    }
+  }
+}
+
+static const uint16_t dividends16[] = { 0U, 1U, 2U, 254U, 255U, 256U, 1000U, 0x5555U, 0x7FFFU, 0x8000U, 0xAAAAU, UINT16_MAX-1U, UINT16_MAX };
+static const uint32_t dividends32[] = {
+  0U, 1U, 2U, 255U, 256U, 65535UL, 65536UL, 1000000UL, 3600000UL,
+  0x55555555UL, 0x7FFFFFFFUL, 0x80000000UL, 0xAAAAAAAAUL, UINT32_MAX-1U, UINT32_MAX,
+};
+
+static void test_fast_div_isr_u16(void) {
+  static const uint8_t divisors8[] = { 1U, 2U, 3U, 7U, 127U, 128U, 129U, 254U, UINT8_MAX };
+  static const uint16_t divisors16[] = { 1U, 2U, 255U, 256U, 257U, 1000U, 0x8000U, UINT16_MAX };
+  assert_fast_div_isr(dividends16, sizeof(dividends16)/sizeof(dividends16[0]), divisors8, sizeof(divisors8)/sizeof(divisors8[0]));
+  assert_fast_div_isr(dividends16, sizeof(dividends16)/sizeof(dividends16[0]), divisors16, sizeof(divisors16)/sizeof(divisors16[0]));
+}
+
+static void test_fast_div_isr_u32(void) {
+  static const uint8_t divisors8[] = { 1U, 2U, 7U, 128U, UINT8_MAX };
+  static const uint16_t divisors16[] = { 1U, 2U, 255U, 256U, 1000U, 0x7FFFU, 0x8000U, UINT16_MAX };
+  static const uint32_t divisors32[] = { 1U, 2U, 1000U, 65535UL, 65536UL, 65537UL, 1000000UL, 0x80000000UL, UINT32_MAX };
+  assert_fast_div_isr(dividends32, sizeof(dividends32)/sizeof(dividends32[0]), divisors8, sizeof(divisors8)/sizeof(divisors8[0]));
+  assert_fast_div_isr(dividends32, sizeof(dividends32)/sizeof(dividends32[0]), divisors16, sizeof(divisors16)/sizeof(divisors16[0]));
+  assert_fast_div_isr(dividends32, sizeof(dividends32)/sizeof(dividends32[0]), divisors32, sizeof(divisors32)/sizeof(divisors32[0]));
+}
+
+static void test_fast_div_isr_zero_divisor(void) {
+#if defined(USE_OPTIMIZED_DIV)
+  // Same as fast_div()
+  TEST_ASSERT_EQUAL_UINT16(0U, fast_div_isr((uint16_t)1000U, (uint8_t)0U));
+  TEST_ASSERT_EQUAL_UINT16(0U, fast_div_isr((uint16_t)1000U, (uint16_t)0U));
+  TEST_ASSERT_EQUAL_UINT32(0U, fast_div_isr(UINT32_MAX, (uint16_t)0U));
+  TEST_ASSERT_EQUAL_UINT32(0U, fast_div_isr(UINT32_MAX, (uint32_t)0U));
+#endif
+}
+
+#if defined(AFD_BACKEND_AVR)
+// The kernels must preserve every register outside their documented clobber set.
+// Load known values into the call-saved & unused call-clobbered registers, call 
+// the kernel, then check them.
+static void test_fast_div_isr_clobbers(void) {
+  // Not one of the registers under test, so the pops can't overwrite it
+  register uint8_t changed asm("r26");
+  asm volatile(
+      "    push r18\n\t"
+      "    push r19\n\t"
+      "    push r27\n\t"
+      "    push r30\n\t"
+      "    push r31\n\t"
+      "    ldi  r18, 0x12\n\t"
+      "    ldi  r19, 0x34\n\t"
+      "    ldi  r27, 0x56\n\t"
+      "    ldi  r30, 0x78\n\t"
+      "    ldi  r31, 0x9A\n\t"
+      "    ldi  r22, 0x40\n\t"   // 1000000/1000
+      "    ldi  r23, 0x42\n\t"
+      "    ldi  r24, 0x0F\n\t"
+      "    ldi  r25, 0x00\n\t"
+      "    ldi  r20, 0xE8\n\t"
+      "    ldi  r21, 0x03\n\t"
+      "    %~call __afd_isr_div32_16\n\t"
+      "    ldi  r24, 0xE8\n\t"   // 1000/7
+      "    ldi  r25, 0x03\n\t"
+      "    ldi  r22, 7\n\t"
+      "    %~call __afd_isr_div16_8\n\t"
+      "    clr  r26\n\t"
+      "    cpi  r18, 0x12\n\t"
+      "    breq 1f\n\t"
+      "    ori  r26, 1\n\t"
+      "1:  cpi  r19, 0x34\n\t"
+      "    breq 2f\n\t"
+      "    ori  r26, 2\n\t"
+      "2:  cpi  r27, 0x56\n\t"
+      "    breq 3f\n\t"
+      "    ori  r26, 4\n\t"
+      "3:  cpi  r30, 0x78\n\t"
+      "    breq 4f\n\t"
+      "    ori  r26, 8\n\t"
+      "4:  cpi  r31, 0x9A\n\t"
+      "    breq 5f\n\t"
+      "    ori  r26, 16\n\t"
+      "5:  cpi  r24, 142\n\t"
+      "    breq 6f\n\t"
+      "    ori  r26, 32\n\t"
+      "6:  tst  r1\n\t"
+      "    breq 7f\n\t"
+      "    ori  r26, 64\n\t"
+      "7:\n\t"
+      "    pop  r31\n\t"
+      "    pop  r30\n\t"
+      "    pop  r27\n\t"
+      "    pop  r19\n\t"
+      "    pop  r18\n\t"
+    : "=r" (changed)
+    :
+    : "r20", "r21", "r22", "r23", "r24", "r25"
+  );
+  TEST_ASSERT_EQUAL_HEX8(0U, changed);
+}
+#endif
+
+void test_afd_isr(void) {
+    SET_UNITY_FILENAME() {
+        RUN_TEST(test_fast_div_isr_u16);
+        RUN_TEST(test_fast_div_isr_u32);
+        RUN_TEST(test_fast_div_isr_zero_divisor);
+#if defined(AFD_BACKEND_AVR)
+        RUN_TEST(test_fast_div_isr_clobbers);
+#endif
+    }
+}
@@ -0,0 +1,169 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "afd_profile.h"
+
+#if defined(AFD_PROFILE) && defined(USE_OPTIMIZED_DIV)
+
+// Wrap up the assertion that the counters match the expected path counts
+static void assert_profile(afd_profile_overload_t overload,
+                          uint32_t zero_divisor, uint32_t narrowed, uint32_t kernel,
+                          uint32_t long_division, uint32_t large_divisor, uint32_t native) {
+  const afd_profile_counters_t &counters = afd_profile_get(overload);
+  char msgBuffer[64];
+  sprintf(msgBuffer, "overload %" PRIu8, (uint8_t)overload);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(zero_divisor, counters.zero_divisor, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(narrowed, counters.narrowed, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(kernel, counters.kernel, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(long_division, counters.long_division, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(large_divisor, counters.large_divisor, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(native, counters.native, msgBuffer);
+}
+
+static void test_afd_profile_reset(void) {
+  (void)fast_div((uint16_t)1000U, (uint8_t)7U);
+  (void)fast_div((uint16_t)1000U, (uint8_t)0U);
+  afd_profile_reset();
+  for (uint8_t overload=0U; overload<(uint8_t)AFD_PROFILE_OVERLOAD_COUNT; ++overload) {
+    assert_profile((afd_profile_overload_t)overload, 0U, 0U, 0U, 0U, 0U, 0U);
+  }
+}
+
+static void test_afd_profile_u16(void) {
+  afd_profile_reset();
+  (void)fast_div((uint16_t)1000U, (uint8_t)0U);   // Zero
+  (void)fast_div((uint16_t)1000U, (uint8_t)7U);   // Kernel
+  (void)fast_div((uint16_t)60000U, (uint8_t)7U);  // Native
+  (void)fast_div((uint16_t)60000U, (uint8_t)7U);  // Native
+#if defined(AFD_RECIPROCAL_TABLE)
+  // The reciprocal covers all dividends
+  assert_profile(AFD_PROFILE_DIV_U16_U8, 1U, 0U, 3U, 0U, 0U, 0U);
+#else
+  assert_profile(AFD_PROFILE_DIV_U16_U8, 1U, 0U, 1U, 0U, 0U, 2U);
+#endif
+
+  afd_profile_reset();
+  (void)fast_div((uint16_t)1000U, (uint16_t)7U);   // Narrowed to u16/u8 kernel
+  (void)fast_div((uint16_t)60000U, (uint16_t)300U); // Large divisor
+  assert_profile(AFD_PROFILE_DIV_U16_U16, 0U, 1U, 0U, 0U, 1U, 0U);
+  assert_profile(AFD_PROFILE_DIV_U16_U8, 0U, 0U, 1U, 0U, 0U, 0U);
+
+  // Signed division is counted under the unsigned overload
+  afd_profile_reset();
+  (void)fast_div((int16_t)-1000, (int8_t)7);
+  assert_profile(AFD_PROFILE_DIV_U16_U8, 0U, 0U, 1U, 0U, 0U, 0U);
+}
+
+static void test_afd_profile_u32(void) {
+  afd_profile_reset();
+  (void)fast_div((uint32_t)1000000UL, (uint16_t)0U);    // Zero
+  (void)fast_div((uint32_t)1000000UL, (uint16_t)1000U); // Kernel
+  (void)fast_div(UINT32_MAX, (uint16_t)1000U);          // Native
+  assert_profile(AFD_PROFILE_DIV_U32_U16, 1U, 0U, 1U, 0U, 0U, 1U);
+
+  // The shared u32/u16 helper counts against the calling overload
+  afd_profile_reset();
+  (void)fast_div((uint32_t)1000000UL, (uint32_t)1000UL);   // Kernel
+  (void)fast_div(UINT32_MAX, (uint32_t)100000UL);          // Large divisor
+  assert_profile(AFD_PROFILE_DIV_U32_U32, 0U, 0U, 1U, 0U, 1U, 0U);
+  assert_profile(AFD_PROFILE_DIV_U32_U16, 0U, 0U, 0U, 0U, 0U, 0U);
+
+  afd_profile_reset();
+  (void)fast_divmod((uint32_t)1000000UL, (uint8_t)0U);   // Zero
+  (void)fast_divmod(UINT32_MAX, (uint8_t)100U);          // Native
+  (void)fast_divmod((uint32_t)1000UL, (uint8_t)100U);    // Kernel
+  assert_profile(AFD_PROFILE_DIVMOD_U32_U8, 1U, 0U, 1U, 0U, 0U, 1U);
+}
+
+static void test_afd_profile_u64(void) {
+  afd_profile_reset();
+  (void)fast_div((uint64_t)1000000UL, (uint32_t)1000UL);              // Narrowed to u32/u32
+  (void)fast_div((uint64_t)UINT32_MAX*1000U, (uint32_t)100000UL);     // Kernel
+  (void)fast_div(UINT64_MAX, (uint32_t)100000UL);                     // Long division
+  assert_profile(AFD_PROFILE_DIV_U64_U32, 0U, 1U, 1U, 1U, 0U, 0U);
+  // The 32-bit steps count as internal, not as calls to the public overloads
+  assert_profile(AFD_PROFILE_DIV_U32_U32, 0U, 0U, 0U, 0U, 0U, 0U);
+  assert_profile(AFD_PROFILE_DIVMOD_U32_U32, 0U, 0U, 0U, 0U, 0U, 0U);
+  assert_profile(AFD_PROFILE_INTERNAL, 0U, 0U, 1U, 0U, 1U, 0U);
+}
+
+static void test_afd_profile_mod(void) {
+  afd_profile_reset();
+  (void)fast_mod((uint16_t)1000U, (uint8_t)0U);    // Zero
+  (void)fast_mod((uint16_t)60000U, (uint8_t)7U);   // Upper byte reduced first
+  (void)fast_mod((uint16_t)1000U, (uint8_t)200U);  // Kernel
+  assert_profile(AFD_PROFILE_MOD_U16_U8, 1U, 0U, 1U, 1U, 0U, 0U);
+
+  afd_profile_reset();
+  (void)fast_mod((uint16_t)1000U, (uint16_t)7U);    // Narrowed to u16%u8
+  (void)fast_mod((uint16_t)60000U, (uint16_t)300U); // Large divisor
+  assert_profile(AFD_PROFILE_MOD_U16_U16, 0U, 1U, 0U, 0U, 1U, 0U);
+  assert_profile(AFD_PROFILE_MOD_U16_U8, 0U, 0U, 1U, 0U, 0U, 0U);
+
+  // The shared u32%u16 helper counts against the calling overload
+  afd_profile_reset();
+  (void)fast_mod((uint32_t)1000000UL, (uint32_t)1000UL);   // Kernel
+  (void)fast_mod(UINT32_MAX, (uint32_t)1000UL);            // Upper word reduced first
+  (void)fast_mod(UINT32_MAX, (uint32_t)100000UL);          // Large divisor
+  assert_profile(AFD_PROFILE_MOD_U32_U32, 0U, 0U, 1U, 1U, 1U, 0U);
+  assert_profile(AFD_PROFILE_MOD_U32_U16, 0U, 0U, 0U, 0U, 0U, 0U);
+}
+
+static void test_afd_profile_narrow(void) {
+  afd_profile_reset();
+  (void)fast_div16_8((uint16_t)1000U, (uint8_t)0U);
+  (void)fast_div16_8((uint16_t)1000U, (uint8_t)7U);
+  (void)fast_div32_16((uint32_t)1000000UL, (uint16_t)1000U);
+  assert_profile(AFD_PROFILE_DIV16_8, 1U, 0U, 1U, 0U, 0U, 0U);
+  assert_profile(AFD_PROFILE_DIV32_16, 0U, 0U, 1U, 0U, 0U, 0U);
+
+  // _sat() forwards to _checked(), so both count as one overload
+  afd_profile_reset();
+  uint8_t result8;
+  (void)fast_div16_8_checked((uint16_t)1000U, (uint8_t)7U, result8);
+  (void)fast_div16_8_checked((uint16_t)60000U, (uint8_t)7U, result8);
+  (void)fast_div16_8_sat((uint16_t)60000U, (uint8_t)0U);
+  assert_profile(AFD_PROFILE_DIV16_8_CHECKED, 1U, 0U, 1U, 0U, 0U, 0U);
+  TEST_ASSERT_EQUAL_UINT32(1U, afd_profile_get(AFD_PROFILE_DIV16_8_CHECKED).overflow);
+
+  afd_profile_reset();
+  uint16_t result16;
+  (void)fast_div32_16_checked((uint32_t)1000000UL, (uint16_t)1000U, result16);
+  (void)fast_div32_16_sat(UINT32_MAX, (uint16_t)1000U);
+  (void)fast_div32_16_sat(UINT32_MAX, (uint16_t)1000U);
+  assert_profile(AFD_PROFILE_DIV32_16_CHECKED, 0U, 0U, 1U, 0U, 0U, 0U);
+  TEST_ASSERT_EQUAL_UINT32(2U, afd_profile_get(AFD_PROFILE_DIV32_16_CHECKED).overflow);
+}
+
+#if defined(AFD_POW2_DIVISOR)
+static void test_afd_profile_pow2(void) {
+  afd_profile_reset();
+  (void)fast_div((uint16_t)1000U, (uint8_t)64U);           // Shift
+  (void)fast_div((uint16_t)1000U, (uint8_t)0U);            // Zero: not a power of two
+  (void)fast_div((uint32_t)1000000UL, (uint32_t)65536UL);  // Shift
+  (void)fast_div((uint32_t)1000000UL, (uint32_t)1024UL);   // Shift, via the u32/u16 helper
+  (void)fast_div((uint32_t)1000000UL, (uint32_t)1000UL);   // Kernel
+  TEST_ASSERT_EQUAL_UINT32(1U, afd_profile_get(AFD_PROFILE_DIV_U16_U8).pow2);
+  TEST_ASSERT_EQUAL_UINT32(1U, afd_profile_get(AFD_PROFILE_DIV_U16_U8).zero_divisor);
+  TEST_ASSERT_EQUAL_UINT32(2U, afd_profile_get(AFD_PROFILE_DIV_U32_U32).pow2);
+  TEST_ASSERT_EQUAL_UINT32(1U, afd_profile_get(AFD_PROFILE_DIV_U32_U32).kernel);
+}
+#endif
+
+#endif
+
+void test_afd_profile(void) {
+#if defined(AFD_PROFILE) && defined(USE_OPTIMIZED_DIV)
+    SET_UNITY_FILENAME() {
+        RUN_TEST(test_afd_profile_reset);
+        RUN_TEST(test_afd_profile_u16);
+        RUN_TEST(test_afd_profile_u32);
+        RUN_TEST(test_afd_profile_u64);
+        RUN_TEST(test_afd_profile_mod);
+        RUN_TEST(test_afd_profile_narrow);
+#if defined(AFD_POW2_DIVISOR)
+        RUN_TEST(test_afd_profile_pow2);
+#endif
+    }
+#endif
+}
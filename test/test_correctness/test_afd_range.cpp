@@ -0,0 +1,89 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+
+// Count range violations, rather than assert()
+static uint16_t rangeViolations = 0U;
+#define AFD_RANGE_ASSERT(value, lower, upper) \
+  if (!(((value)>=(lower)) && ((value)<=(upper)))) { ++rangeViolations; }
+
+#include "afd_range.h"
+
+using namespace avr_fast_div_impl;
+
+// Kernel selection is the whole point: check it at compile time
+static_assert(select_range_kernel<afd_range<0, 100>, afd_range<101, 200>>()==range_kernel_zero, "Expected zero");
+static_assert(select_range_kernel<afd_range<0, 20000>, afd_range<79, 255>>()==range_kernel_u16_u8, "Expected u16/u8");
+static_assert(select_range_kernel<afd_range<0, 20000>, afd_range<78, 255>>()!=range_kernel_u16_u8, "Quotient won't fit u8");
+#if defined(AFD_HAS_INT24)
+static_assert(select_range_kernel<afd_range<0, 3600000>, afd_range<14063, 65535>>()==range_kernel_u24_u16, "Expected u24/u16");
+static_assert(select_range_kernel<afd_range<0, 3600000>, afd_range<55, 255>>()==range_kernel_u24_u8, "Expected u24/u8");
+#endif
+static_assert(select_range_kernel<afd_range<0, 3600000>, afd_range<65, 65535>>()==range_kernel_u32_u16, "Expected u32/u16");
+static_assert(select_range_kernel<afd_range<0, UINT32_MAX>, afd_range<65536, UINT32_MAX>>()==range_kernel_runtime, "Large divisor: expected runtime");
+static_assert(select_range_kernel<afd_range<0, UINT32_MAX>, afd_range<0, UINT16_MAX>>()==range_kernel_runtime, "Zero divisor: expected runtime");
+static_assert(select_range_kernel<afd_range<0, UINT32_MAX>, afd_range<1, UINT16_MAX>>()==range_kernel_runtime, "Quotient won't fit u16");
+
+// Wrap up the assertion that the range division matches the division operator
+// at the range corners, plus a spread in between
+template <typename TDividendRange, typename TDivisorRange, typename TDividend, typename TDivisor>
+static void assert_afd_range(void) {
+  constexpr uint8_t steps = 37U;
+  const TDividend dividendStep = (TDividend)((TDividendRange::upper-TDividendRange::lower)/steps);
+  const TDivisor divisorStep = (TDivisor)((TDivisorRange::upper-TDivisorRange::lower)/steps);
+  for (uint8_t dividendIndex=0U; dividendIndex<=steps+1U; ++dividendIndex) {
+    const TDividend dividend = dividendIndex>steps ? (TDividend)TDividendRange::upper : (TDividend)(TDividendRange::lower + (dividendStep*dividendIndex));
+    for (uint8_t divisorIndex=0U; divisorIndex<=steps+1U; ++divisorIndex) {
+      const TDivisor divisor = divisorIndex>steps ? (TDivisor)TDivisorRange::upper : (TDivisor)(TDivisorRange::lower + (divisorStep*divisorIndex));
+      if (divisor==0U) {
+        continue; // Division by zero on Teensy generates an exception
+      }
+      char msgBuffer[64];
+      sprintf(msgBuffer, "%" PRIu32 ", %" PRIu32, (uint32_t)dividend, (uint32_t)divisor);
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend/divisor, (fast_div<TDividendRange, TDivisorRange>(dividend, divisor)), msgBuffer);
+    }
+  }
+}
+
+static void test_afd_range_kernels(void) {
+  rangeViolations = 0U;
+  assert_afd_range<afd_range<0, 100>, afd_range<101, 200>, uint16_t, uint8_t>();
+  assert_afd_range<afd_range<0, 20000>, afd_range<79, 255>, uint16_t, uint16_t>();
+  assert_afd_range<afd_range<0, 20000>, afd_range<79, 255>, uint32_t, uint32_t>();
+  assert_afd_range<afd_range<0, 3600000>, afd_range<14063, 65535>, uint32_t, uint32_t>();
+  assert_afd_range<afd_range<0, 3600000>, afd_range<55, 255>, uint32_t, uint8_t>();
+  assert_afd_range<afd_range<0, 3600000>, afd_range<65, 65535>, uint32_t, uint32_t>();
+  assert_afd_range<afd_range<0, UINT32_MAX>, afd_range<65536, UINT32_MAX>, uint32_t, uint32_t>();
+  assert_afd_range<afd_range<1000, 2000>, afd_range<1000, 2000>, uint16_t, uint16_t>();
+  TEST_ASSERT_EQUAL_UINT16(0U, rangeViolations);
+}
+
+static void test_afd_range_runtime(void) {
+  rangeViolations = 0U;
+  assert_afd_range<afd_range<0, UINT32_MAX>, afd_range<1, UINT16_MAX>, uint32_t, uint32_t>();
+  assert_afd_range<afd_range<0, UINT16_MAX>, afd_range<1, UINT32_MAX>, uint32_t, uint32_t>();
+  assert_afd_range<afd_range<0, UINT8_MAX>, afd_range<1, UINT8_MAX>, uint8_t, uint8_t>();
+  TEST_ASSERT_EQUAL_UINT16(0U, rangeViolations);
+#if defined(USE_OPTIMIZED_DIV)
+  // Same as fast_div()
+  TEST_ASSERT_EQUAL_UINT32(0U, (fast_div<afd_range<0, UINT32_MAX>, afd_range<0, UINT16_MAX>>((uint32_t)1000U, (uint32_t)0U)));
+#endif
+}
+
+static void test_afd_range_assert(void) {
+  rangeViolations = 0U;
+  (void)fast_div<afd_range<0, 20000>, afd_range<79, 255>>((uint16_t)20001U, (uint8_t)100U);
+  TEST_ASSERT_EQUAL_UINT16(1U, rangeViolations);
+  (void)fast_div<afd_range<0, 20000>, afd_range<79, 255>>((uint16_t)20000U, (uint8_t)78U);
+  TEST_ASSERT_EQUAL_UINT16(2U, rangeViolations);
+  (void)fast_div<afd_range<10, 20000>, afd_range<79, 255>>((uint16_t)9U, (uint8_t)79U);
+  TEST_ASSERT_EQUAL_UINT16(3U, rangeViolations);
+}
+
+void test_afd_range(void) {
+    SET_UNITY_FILENAME() {
+        RUN_TEST(test_afd_range_kernels);
+        RUN_TEST(test_afd_range_runtime);
+        RUN_TEST(test_afd_range_assert);
+    }
+}
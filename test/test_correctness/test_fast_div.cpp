@@ -56,6 +56,89 @@ static void assert_fastdiv(TDividend dividend, TDivisor divisor, bool is_signed)
   }
 }
 
+// Wrap up the assertion that {a/b, a%b}==fast_divmod(a,b)
+template <typename TDividend, typename TDivisor>
+static void assert_fastdivmod(TDividend dividend, TDivisor divisor, bool is_signed) {
+  TDividend expectedQuot = 0;
+  TDivisor expectedRem = 0;
+  if (divisor!=0) { // Division by zero on Teensy generates an exception
+    expectedQuot = (TDividend)(dividend/divisor);
+    expectedRem = (TDivisor)(dividend%divisor);
+  }
+  afd_divmod_t<TDividend, TDivisor> actual = fast_divmod(dividend, divisor);
+  
+  char msgBuffer[256];
+  if (is_signed) {
+    sprintf(msgBuffer, "%s: %" PRId32 ", %" PRId32, __PRETTY_FUNCTION__, (int32_t)dividend, (int32_t)divisor);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(expectedQuot, actual.quot, msgBuffer);
+    if (divisor!=0) { // Division by zero behavior is platform specific
+      TEST_ASSERT_EQUAL_INT32_MESSAGE(expectedRem, actual.rem, msgBuffer);
+    }
+  } else {
+    sprintf(msgBuffer, "%s: %" PRIu32 ", %" PRIu32, __PRETTY_FUNCTION__, (uint32_t)dividend, (uint32_t)divisor);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expectedQuot, actual.quot, msgBuffer);
+    if (divisor!=0) {
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(expectedRem, actual.rem, msgBuffer);
+    }
+  }
+}
+
+// Wrap up the assertion that a%b==fast_mod(a,b)
+template <typename TDividend, typename TDivisor>
+static void assert_fastmod(TDividend dividend, TDivisor divisor, bool is_signed) {
+  if (divisor==0) { // Division by zero behavior is platform specific
+    return;
+  }
+  TDivisor expected = (TDivisor)(dividend%divisor);
+  TDivisor actual = fast_mod(dividend, divisor);
+  
+  char msgBuffer[256];
+  if (is_signed) {
+    sprintf(msgBuffer, "%s: %" PRId32 ", %" PRId32, __PRETTY_FUNCTION__, (int32_t)dividend, (int32_t)divisor);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(expected, actual, msgBuffer);
+  } else {
+    sprintf(msgBuffer, "%s: %" PRIu32 ", %" PRIu32, __PRETTY_FUNCTION__, (uint32_t)dividend, (uint32_t)divisor);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected, actual, msgBuffer);
+  }
+}
+
+// Wrap up the assertion that ceil(a/b)==fast_div_ceil(a,b) and round(a/b)==fast_div_round(a,b)
+template <typename TDividend, typename TDivisor>
+static void assert_fastdivrounding(TDividend dividend, TDivisor divisor, bool is_signed) {
+  if (divisor==0) { // Division by zero behavior is platform specific
+    return;
+  }
+  // Reference results, in a wide type to avoid overflow. Calculated on the
+  // absolute values, then the sign is applied.
+  const uint64_t udividend = dividend<0 ? (uint64_t)-(int64_t)dividend : (uint64_t)dividend;
+  const uint64_t udivisor = divisor<0 ? (uint64_t)-(int64_t)divisor : (uint64_t)divisor;
+  const bool isNegative = (dividend<0) != (divisor<0);
+  const int64_t expectedCeil = isNegative ? -(int64_t)(udividend/udivisor) : (int64_t)((udividend+udivisor-1U)/udivisor);
+  const int64_t expectedRound = isNegative ? -(int64_t)(((2U*udividend)+udivisor)/(2U*udivisor)) : (int64_t)(((2U*udividend)+udivisor)/(2U*udivisor));
+
+  TDividend actualCeil = fast_div_ceil(dividend, divisor);
+  TDividend actualRound = fast_div_round(dividend, divisor);
+
+  char msgBuffer[256];
+  if (is_signed) {
+    sprintf(msgBuffer, "%s: %" PRId32 ", %" PRId32, __PRETTY_FUNCTION__, (int32_t)dividend, (int32_t)divisor);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE((TDividend)expectedCeil, actualCeil, msgBuffer);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE((TDividend)expectedRound, actualRound, msgBuffer);
+  } else {
+    sprintf(msgBuffer, "%s: %" PRIu32 ", %" PRIu32, __PRETTY_FUNCTION__, (uint32_t)dividend, (uint32_t)divisor);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE((TDividend)expectedCeil, actualCeil, msgBuffer);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE((TDividend)expectedRound, actualRound, msgBuffer);
+  }
+}
+
+template <typename TDividend, typename TDivisor>
+static void assert_all(TDividend dividend, TDivisor divisor, bool is_signed) {
+  assert_fastdiv(dividend, divisor, is_signed);
+  assert_fastdivmod(dividend, divisor, is_signed);
+  assert_fastmod(dividend, divisor, is_signed);
+  assert_fastdivrounding(dividend, divisor, is_signed);
+}
+
 template <typename T, typename R = type_traits::make_unsigned_t<T>>
 static inline R absDelta(const T &min, const T &max) {
   if (min<0) {
@@ -94,23 +177,23 @@ static void test_fastdiv_range(TDividend divMin, TDividend divMax, TDivisor divi
 #if defined(DETAILED_MESSAGES)
   TEST_MESSAGE("Testing range corners");
 #endif
-  assert_fastdiv(divMax,     divMax, is_signed);
-  assert_fastdiv(divMax,     divMin, is_signed);
-  assert_fastdiv(divMax,     divisorMin, is_signed);
-  assert_fastdiv(divMax,     divisorMax, is_signed);
-  assert_fastdiv(divMin,     divMax, is_signed);
-  assert_fastdiv(divMin,     divMin, is_signed);
-  assert_fastdiv(divMin,     divisorMin, is_signed);
-  assert_fastdiv(divMin,     divisorMax, is_signed);
+  assert_all(divMax,     divMax, is_signed);
+  assert_all(divMax,     divMin, is_signed);
+  assert_all(divMax,     divisorMin, is_signed);
+  assert_all(divMax,     divisorMax, is_signed);
+  assert_all(divMin,     divMax, is_signed);
+  assert_all(divMin,     divMin, is_signed);
+  assert_all(divMin,     divisorMin, is_signed);
+  assert_all(divMin,     divisorMax, is_signed);
   // These are not valid
-  // assert_fastdiv(divisorMax, divMax, is_signed);
-  // assert_fastdiv(divisorMax, divMin, is_signed);
-  // assert_fastdiv(divisorMax, divisorMin, is_signed);
-  // assert_fastdiv(divisorMax, divisorMax, is_signed);
-  // assert_fastdiv(divisorMin, divMax, is_signed);
-  // assert_fastdiv(divisorMin, divMin, is_signed);
-  // assert_fastdiv(divisorMin, divisorMin, is_signed);
-  // assert_fastdiv(divisorMin, divisorMax, is_signed);
+  // assert_all(divisorMax, divMax, is_signed);
+  // assert_all(divisorMax, divMin, is_signed);
+  // assert_all(divisorMax, divisorMin, is_signed);
+  // assert_all(divisorMax, divisorMax, is_signed);
+  // assert_all(divisorMin, divMax, is_signed);
+  // assert_all(divisorMin, divMin, is_signed);
+  // assert_all(divisorMin, divisorMin, is_signed);
+  // assert_all(divisorMin, divisorMax, is_signed);
 
 #if defined(EXTENDED_TEST_LEVEL) && (EXTENDED_TEST_LEVEL>0)
   using udividend_t = typename type_traits::make_unsigned_t<TDividend>;
@@ -140,7 +223,7 @@ static void test_fastdiv_range(TDividend divMin, TDividend divMax, TDivisor divi
     for (uint32_t innerIndex=0; innerIndex<EXTENDED_TEST_LEVEL; ++innerIndex) {
       TDivisor divisor = (TDivisor)(divisorMin + (divisorStep*innerIndex));
       UNITY_OUTPUT_CHAR('.');
-      assert_fastdiv(dividend, divisor, is_signed);
+      assert_all(dividend, divisor, is_signed);
     }
     UNITY_OUTPUT_CHAR('\n');
   }
@@ -191,6 +274,26 @@ static void test_fast_div_u16_u8(void) {
   TEST_ASSERT_EQUAL_UINT8(0, fast_div16_8(0, 0));
   TEST_ASSERT_EQUAL_UINT8(1, fast_div16_8(1, 1));
   TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, fast_div16_8((uint16_t)UINT8_MAX*UINT8_MAX, UINT8_MAX));
+
+  // Test the checked & saturating variants, on both sides of the limit
+  uint8_t result;
+  TEST_ASSERT_TRUE(fast_div16_8_checked((uint16_t)UINT8_MAX*UINT8_MAX, UINT8_MAX, result));
+  TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, result);
+  TEST_ASSERT_TRUE(fast_div16_8_checked(1000U, 4U, result));
+  TEST_ASSERT_EQUAL_UINT8(250U, result);
+  TEST_ASSERT_FALSE(fast_div16_8_checked(1024U, 4U, result));
+  TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, result);
+  TEST_ASSERT_FALSE(fast_div16_8_checked(UINT16_MAX, 1U, result));
+  TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, result);
+  TEST_ASSERT_EQUAL_UINT8(250U, fast_div16_8_sat(1000U, 4U));
+  TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, fast_div16_8_sat(1024U, 4U));
+  TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, fast_div16_8_sat(UINT16_MAX, UINT8_MAX-1U));
+  TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, fast_div16_8_sat((uint16_t)UINT8_MAX*UINT8_MAX+(UINT8_MAX-1U), UINT8_MAX));
+#if defined(USE_OPTIMIZED_DIV)
+  TEST_ASSERT_FALSE(fast_div16_8_checked(1000U, 0U, result));
+  TEST_ASSERT_EQUAL_UINT8(0U, result);
+  TEST_ASSERT_EQUAL_UINT8(0U, fast_div16_8_sat(1000U, 0U));
+#endif
 }
 
 static void test_fast_div_s16_s8(void) {
@@ -215,10 +318,131 @@ static void test_fast_div_32_16(void) {
   TEST_ASSERT_EQUAL_UINT16(0, fast_div32_16(0, 0));
   TEST_ASSERT_EQUAL_UINT16(1, fast_div32_16(1, 1));
   TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, fast_div32_16((uint32_t)UINT16_MAX*UINT16_MAX, UINT16_MAX));
+
+  // Test the checked & saturating variants, on both sides of the limit
+  uint16_t result;
+  TEST_ASSERT_TRUE(fast_div32_16_checked((uint32_t)UINT16_MAX*UINT16_MAX, UINT16_MAX, result));
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, result);
+  TEST_ASSERT_TRUE(fast_div32_16_checked(60000000UL, 1000U, result));
+  TEST_ASSERT_EQUAL_UINT16(60000U, result);
+  TEST_ASSERT_FALSE(fast_div32_16_checked(65536000UL, 1000U, result));
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, result);
+  TEST_ASSERT_FALSE(fast_div32_16_checked(UINT32_MAX, 1U, result));
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, result);
+  TEST_ASSERT_EQUAL_UINT16(60000U, fast_div32_16_sat(60000000UL, 1000U));
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, fast_div32_16_sat(65536000UL, 1000U));
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, fast_div32_16_sat(UINT32_MAX, UINT16_MAX-1U));
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, fast_div32_16_sat((uint32_t)UINT16_MAX*UINT16_MAX+(UINT16_MAX-1U), UINT16_MAX));
+#if defined(USE_OPTIMIZED_DIV)
+  TEST_ASSERT_FALSE(fast_div32_16_checked(1000U, 0U, result));
+  TEST_ASSERT_EQUAL_UINT16(0U, result);
+  TEST_ASSERT_EQUAL_UINT16(0U, fast_div32_16_sat(1000U, 0U));
+#endif
 }
 static void test_fast_div_32_8(void) {
   test_type_ranges<uint32_t, uint8_t>();
 }
+static void test_fast_mod_zero_divisor(void) {
+#if defined(USE_OPTIMIZED_DIV)
+  TEST_ASSERT_EQUAL_UINT8(0, fast_mod((uint16_t)UINT16_MAX, (uint8_t)0U));
+  TEST_ASSERT_EQUAL_UINT16(0, fast_mod((uint32_t)UINT32_MAX, (uint16_t)0U));
+  TEST_ASSERT_EQUAL_UINT32(0, fast_mod((uint32_t)UINT32_MAX, (uint32_t)0U));
+#endif
+}
+static void test_fast_mod_upper_reduction(void) {
+  // Quotient doesn't fit into the divisor type, so the upper half is reduced first
+  TEST_ASSERT_EQUAL_UINT8(UINT16_MAX % 3U, fast_mod((uint16_t)UINT16_MAX, (uint8_t)3U));
+  TEST_ASSERT_EQUAL_UINT8(UINT16_MAX % UINT8_MAX, fast_mod((uint16_t)UINT16_MAX, (uint8_t)UINT8_MAX));
+  TEST_ASSERT_EQUAL_UINT16(UINT32_MAX % 7U, fast_mod((uint32_t)UINT32_MAX, (uint16_t)7U));
+  TEST_ASSERT_EQUAL_UINT16(UINT32_MAX % UINT16_MAX, fast_mod((uint32_t)UINT32_MAX, (uint16_t)UINT16_MAX));
+  TEST_ASSERT_EQUAL_UINT8(UINT32_MAX % 253U, fast_mod((uint32_t)UINT32_MAX, (uint8_t)253U));
+  TEST_ASSERT_EQUAL_INT16(-(INT32_MAX % 1234), fast_mod((int32_t)-INT32_MAX, (int16_t)-1234));
+}
+static void test_fast_div_ct(void) {
+  static const uint32_t values[] = {
+    0U, 1U, 2U, 3U, 7U, 255U, 256U, 1000U, 65535UL, 65536UL, 1000000UL, 
+    0x55555555UL, 0x7FFFFFFFUL, 0x80000000UL, 0x80000001UL, 0xAAAAAAAAUL, UINT32_MAX-1U, UINT32_MAX,
+  };
+  for (size_t dividendIndex=0U; dividendIndex<sizeof(values)/sizeof(values[0]); ++dividendIndex) {
+    for (size_t divisorIndex=1U; divisorIndex<sizeof(values)/sizeof(values[0]); ++divisorIndex) {
+      const uint32_t dividend = values[dividendIndex];
+      const uint32_t divisor = values[divisorIndex];
+      char msgBuffer[64];
+      sprintf(msgBuffer, "%" PRIu32 ", %" PRIu32, dividend, divisor);
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend/divisor, fast_div_ct(dividend, divisor), msgBuffer);
+    }
+  }
+#if defined(USE_OPTIMIZED_DIV)
+  TEST_ASSERT_EQUAL_UINT32(0U, fast_div_ct(UINT32_MAX, 0U));
+#endif
+}
+template <typename TDividend, typename TDivisor>
+static void assert_fast_div_mixed(TDividend dividend, TDivisor divisor) {
+  using result_t = decltype(fast_div_mixed(dividend, divisor));
+  const result_t expected = (result_t)((int64_t)dividend / (int64_t)divisor);
+  char msgBuffer[64];
+  sprintf(msgBuffer, "%" PRId32 ", %" PRId32, (int32_t)dividend, (int32_t)divisor);
+  TEST_ASSERT_EQUAL_INT64_MESSAGE(expected, fast_div_mixed(dividend, divisor), msgBuffer);
+}
+
+static void test_fast_div_mixed(void) {
+  // Signed dividend: the result is the dividend type
+  static_assert(type_traits::is_same<decltype(fast_div_mixed((int16_t)0, (uint8_t)1U)), int16_t>::value, "Incorrect result type");
+  for (int32_t dividend=INT16_MIN; dividend<=INT16_MAX; dividend+=257) {
+      for (uint16_t divisor=1U; divisor<=UINT8_MAX; divisor+=17U) {
+      assert_fast_div_mixed((int16_t)dividend, (uint8_t)divisor);
+    }
+  }
+  assert_fast_div_mixed((int16_t)INT16_MIN, (uint8_t)1U);
+  assert_fast_div_mixed((int16_t)INT16_MIN, (uint8_t)UINT8_MAX);
+  assert_fast_div_mixed((int16_t)-10, (uint8_t)3U);
+  assert_fast_div_mixed((int8_t)INT8_MIN, (uint8_t)1U);
+  assert_fast_div_mixed((int32_t)INT32_MIN, (uint16_t)UINT16_MAX);
+  assert_fast_div_mixed((int32_t)-1000000L, (uint16_t)7U);
+  assert_fast_div_mixed((int32_t)INT32_MIN, (uint32_t)UINT32_MAX);
+
+  // Unsigned dividend: the result is the next wider signed type
+  static_assert(type_traits::is_same<decltype(fast_div_mixed((uint16_t)0U, (int8_t)1)), int32_t>::value, "Incorrect result type");
+  assert_fast_div_mixed((uint16_t)UINT16_MAX, (int8_t)-1);
+  assert_fast_div_mixed((uint16_t)UINT16_MAX, (int8_t)INT8_MIN);
+  assert_fast_div_mixed((uint16_t)1000U, (int8_t)7);
+  assert_fast_div_mixed((uint16_t)1000U, (int16_t)-300);
+  assert_fast_div_mixed((uint8_t)UINT8_MAX, (int8_t)-1);
+  assert_fast_div_mixed((uint32_t)UINT16_MAX, (int16_t)-2);
+#if defined(USE_OPTIMIZED_DIV)
+  TEST_ASSERT_EQUAL_INT16(0, fast_div_mixed((int16_t)-1000, (uint8_t)0U));
+#endif
+}
+
+// Every power of two divisor, plus its neighbours: exercises AFD_POW2_DIVISOR
+// on both outcomes
+template <typename TDividend, typename TDivisor>
+static void assert_fastdiv_pow2(const TDividend *pDividends, uint8_t numDividends) {
+  for (uint8_t shift=0U; shift<sizeof(TDivisor)*CHAR_BIT; ++shift) {
+    const TDivisor pow2 = (TDivisor)((TDivisor)1U << shift);
+    for (uint8_t index=0U; index<numDividends; ++index) {
+      assert_fastdiv(pDividends[index], pow2, false);
+      assert_fastdiv(pDividends[index], (TDivisor)(pow2+1U), false);
+      assert_fastdiv(pDividends[index], (TDivisor)(pow2-1U), false);
+    }
+  }
+}
+
+static void test_fast_div_pow2(void) {
+  static const uint16_t dividends16[] = { 0U, 1U, 255U, 256U, 1000U, 32768U, UINT16_MAX };
+  assert_fastdiv_pow2<uint16_t, uint8_t>(dividends16, sizeof(dividends16)/sizeof(dividends16[0]));
+  assert_fastdiv_pow2<uint16_t, uint16_t>(dividends16, sizeof(dividends16)/sizeof(dividends16[0]));
+  static const uint32_t dividends32[] = { 0U, 1U, UINT16_MAX, 3600000UL, 0x80000000UL, 0xDEADBEEFUL, UINT32_MAX };
+  assert_fastdiv_pow2<uint32_t, uint8_t>(dividends32, sizeof(dividends32)/sizeof(dividends32[0]));
+  assert_fastdiv_pow2<uint32_t, uint16_t>(dividends32, sizeof(dividends32)/sizeof(dividends32[0]));
+  assert_fastdiv_pow2<uint32_t, uint32_t>(dividends32, sizeof(dividends32)/sizeof(dividends32[0]));
+#if defined(USE_OPTIMIZED_DIV)
+  // Zero isn't a power of two
+  TEST_ASSERT_EQUAL_UINT32(0U, fast_div((uint32_t)1000U, (uint32_t)0U));
+  TEST_ASSERT_EQUAL_UINT16(0U, fast_div((uint16_t)1000U, (uint8_t)0U));
+#endif
+}
+
 static void test_fast_div_s32_s32(void) {
   test_type_ranges<int32_t>();
 }
@@ -233,15 +457,322 @@ static void test_fast_div_32(void) {
   RUN_TEST(test_fast_div_32_32);
   RUN_TEST(test_fast_div_32_16);
   RUN_TEST(test_fast_div_32_8);
+  RUN_TEST(test_fast_mod_zero_divisor);
+  RUN_TEST(test_fast_mod_upper_reduction);
+  RUN_TEST(test_fast_div_ct);
+  RUN_TEST(test_fast_div_mixed);
+  RUN_TEST(test_fast_div_pow2);
   RUN_TEST(test_fast_div_s32_s32);
   RUN_TEST(test_fast_div_s32_s16);
   RUN_TEST(test_fast_div_s32_s8); 
 }
 
+#if defined(AFD_HAS_INT24)
+static constexpr uint32_t test_values_u24[] = {
+  0U, 1U, 3U, 7U, UINT8_MAX, (uint32_t)UINT8_MAX+1U, 1000U, 4095U, UINT16_MAX, (uint32_t)UINT16_MAX+1U, 
+  3600000UL,                // 1 hour in milliseconds
+  __UINT24_MAX__/3U, __UINT24_MAX__-1U, __UINT24_MAX__,
+};
+
+template <typename TDividend, typename TDivisor>
+static void test_fastdiv24_table(bool is_signed) {
+  for (uint8_t dividendIndex=0; dividendIndex<sizeof(test_values_u24)/sizeof(test_values_u24[0]); ++dividendIndex) {
+    for (uint8_t divisorIndex=0; divisorIndex<sizeof(test_values_u24)/sizeof(test_values_u24[0]); ++divisorIndex) {
+      assert_fastdiv((TDividend)test_values_u24[dividendIndex], (TDivisor)test_values_u24[divisorIndex], is_signed);
+      // Avoid INT24_MIN, which overflows
+      if (is_signed && (test_values_u24[dividendIndex]<=(uint32_t)__INT24_MAX__)) {
+        assert_fastdiv((TDividend)-(int32_t)test_values_u24[dividendIndex], (TDivisor)test_values_u24[divisorIndex], is_signed);
+      }
+    }
+  }
+}
+
+static void test_fast_div_u24_u24(void) {
+  test_fastdiv24_table<__uint24, __uint24>(false);
+}
+static void test_fast_div_u24_u16(void) {
+  test_fastdiv24_table<__uint24, uint16_t>(false);
+}
+static void test_fast_div_u24_u8(void) {
+  test_fastdiv24_table<__uint24, uint8_t>(false);
+}
+static void test_fast_div_s24_s24(void) {
+  test_fastdiv24_table<__int24, __int24>(true);
+}
+static void test_fast_div_s24_s8(void) {
+  test_fastdiv24_table<__int24, int8_t>(true);
+}
+
+static void test_fast_div_24(void) {
+  RUN_TEST(test_fast_div_u24_u24);
+  RUN_TEST(test_fast_div_u24_u16);
+  RUN_TEST(test_fast_div_u24_u8);
+  RUN_TEST(test_fast_div_s24_s24);
+  RUN_TEST(test_fast_div_s24_s8);
+}
+#endif
+
+#if defined(UNITY_SUPPORT_64)
+// Wrap up the assertion that a/b==fast_div(a,b) for 64-bit dividends
+template <typename TDividend, typename TDivisor>
+static void assert_fastdiv64(TDividend dividend, TDivisor divisor) {
+  TDividend expected = 0;
+  if (divisor!=0) { // Division by zero on Teensy generates an exception
+    expected = (TDividend)(dividend/divisor);
+  }
+  TDividend actual = fast_div(dividend, divisor);
+
+  // printf on AVR doesn't support 64-bit integers
+  char msgBuffer[256];
+  sprintf(msgBuffer, "%s: 0x%08" PRIX32 "%08" PRIX32 ", 0x%08" PRIX32 "%08" PRIX32, __PRETTY_FUNCTION__, 
+          (uint32_t)((uint64_t)dividend >> 32U), (uint32_t)dividend, 
+          (uint32_t)((uint64_t)divisor >> 32U), (uint32_t)divisor);
+  TEST_ASSERT_EQUAL_UINT64_MESSAGE((uint64_t)expected, (uint64_t)actual, msgBuffer);
+}
+
+static constexpr uint64_t test_dividends_u64[] = {
+  0U, 1U, UINT8_MAX, UINT16_MAX, UINT32_MAX, (uint64_t)UINT32_MAX+1U,
+  3600000000ULL,            // 1 hour in microseconds
+  86400000000ULL,           // 1 day in microseconds
+  0x123456789ABCDEF0ULL, UINT64_MAX/3U, UINT64_MAX-1U, UINT64_MAX,
+};
+
+static constexpr uint64_t test_divisors_u64[] = {
+  0U, 1U, 7U, UINT8_MAX, 1000U, UINT16_MAX, 1000000UL, (uint64_t)UINT16_MAX+1U, UINT32_MAX/7U, UINT32_MAX,
+  (uint64_t)UINT32_MAX+1U, 0x123456789ULL, UINT64_MAX/3U, UINT64_MAX,
+};
+
+template <typename TDividend, typename TDivisor>
+static void test_fastdiv64_table(void) {
+  for (uint8_t dividendIndex=0; dividendIndex<sizeof(test_dividends_u64)/sizeof(test_dividends_u64[0]); ++dividendIndex) {
+    for (uint8_t divisorIndex=0; divisorIndex<sizeof(test_divisors_u64)/sizeof(test_divisors_u64[0]); ++divisorIndex) {
+      const TDividend dividend = (TDividend)test_dividends_u64[dividendIndex];
+      const TDivisor divisor = (TDivisor)test_divisors_u64[divisorIndex];
+      // Avoid INT64_MIN/-1, which overflows
+      if (!(dividend==(TDividend)INT64_MIN && divisor==(TDivisor)-1)) {
+        assert_fastdiv64(dividend, divisor);
+      }
+    }
+  }
+}
+
+static void test_fast_div_u64_u64(void) {
+  test_fastdiv64_table<uint64_t, uint64_t>();
+}
+static void test_fast_div_u64_u32(void) {
+  test_fastdiv64_table<uint64_t, uint32_t>();
+}
+static void test_fast_div_u64_u16(void) {
+  test_fastdiv64_table<uint64_t, uint16_t>();
+}
+static void test_fast_div_u64_u8(void) {
+  test_fastdiv64_table<uint64_t, uint8_t>();
+}
+static void test_fast_div_s64_s64(void) {
+  test_fastdiv64_table<int64_t, int64_t>();
+}
+static void test_fast_div_s64_s32(void) {
+  test_fastdiv64_table<int64_t, int32_t>();
+}
+
+static void test_fast_div_u64_pow2(void) {
+  for (uint8_t shift=0U; shift<64U; ++shift) {
+    const uint64_t pow2 = (uint64_t)1U << shift;
+    assert_fastdiv64((uint64_t)UINT64_MAX, pow2);
+    assert_fastdiv64((uint64_t)0x123456789ABCDEF0ULL, pow2);
+    assert_fastdiv64((uint64_t)0x123456789ABCDEF0ULL, (uint64_t)(pow2+1U));
+    if (shift<32U) {
+      assert_fastdiv64((uint64_t)UINT64_MAX, (uint32_t)pow2);
+      assert_fastdiv64((uint64_t)0x123456789ABCDEF0ULL, (uint32_t)pow2);
+    }
+  }
+}
+
+static void test_fast_div_64(void) {
+  RUN_TEST(test_fast_div_u64_u64);
+  RUN_TEST(test_fast_div_u64_u32);
+  RUN_TEST(test_fast_div_u64_u16);
+  RUN_TEST(test_fast_div_u64_u8);
+  RUN_TEST(test_fast_div_s64_s64);
+  RUN_TEST(test_fast_div_s64_s32);
+  RUN_TEST(test_fast_div_u64_pow2);
+}
+#endif
+
+// Wrap up the assertion that (a*b)/c==fast_muldiv(a,b,c), with & without saturation
+template <typename TMultiplier, typename TDivisor>
+static void assert_fastmuldiv(uint16_t a, TMultiplier b, TDivisor divisor) {
+  const uint32_t expected = ((uint32_t)a * b) / divisor;
+  char msgBuffer[256];
+  sprintf(msgBuffer, "%s: %" PRIu16 ", %" PRIu32 ", %" PRIu32, __PRETTY_FUNCTION__, a, (uint32_t)b, (uint32_t)divisor);
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE((uint16_t)expected, fast_muldiv(a, b, divisor), msgBuffer);
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE(expected > UINT16_MAX ? (uint16_t)UINT16_MAX : (uint16_t)expected, fast_muldiv_sat(a, b, divisor), msgBuffer);
+}
+
+static void test_fast_muldiv_u16_u16(void) {
+  static const uint16_t values[] = { 1U, 2U, 3U, 7U, 100U, 255U, 256U, 1023U, 4096U, 7715U, 32767U, 32768U, UINT16_MAX-1U, UINT16_MAX };
+  for (uint8_t a=0; a<sizeof(values)/sizeof(values[0]); ++a) {
+    for (uint8_t b=0; b<sizeof(values)/sizeof(values[0]); ++b) {
+      for (uint8_t c=0; c<sizeof(values)/sizeof(values[0]); ++c) {
+        assert_fastmuldiv(values[a], values[b], values[c]);
+      }
+    }
+  }
+  assert_fastmuldiv<uint16_t, uint16_t>(0U, UINT16_MAX, 1U);
+  // Either side of the quotient fitting: the product's upper word is divisor-1 or divisor
+  assert_fastmuldiv<uint16_t, uint16_t>(UINT16_MAX, UINT16_MAX, UINT16_MAX-1U);
+  assert_fastmuldiv<uint16_t, uint16_t>(UINT16_MAX, UINT16_MAX, UINT16_MAX);
+  assert_fastmuldiv<uint16_t, uint16_t>(32768U, 4U, 1U);
+  assert_fastmuldiv<uint16_t, uint16_t>(32768U, 4U, 2U);
+  assert_fastmuldiv<uint16_t, uint16_t>(32768U, 4U, 3U);
+#if defined(USE_OPTIMIZED_DIV)
+  TEST_ASSERT_EQUAL_UINT16(0U, fast_muldiv((uint16_t)UINT16_MAX, (uint16_t)UINT16_MAX, (uint16_t)0U));
+  TEST_ASSERT_EQUAL_UINT16(0U, fast_muldiv_sat((uint16_t)UINT16_MAX, (uint16_t)UINT16_MAX, (uint16_t)0U));
+#endif
+}
+
+static void test_fast_muldiv_u16_u8(void) {
+  static const uint16_t dividends[] = { 0U, 1U, 3U, 100U, 256U, 1023U, 7715U, 32768U, UINT16_MAX };
+  static const uint8_t values[] = { 1U, 2U, 3U, 7U, 10U, 100U, 127U, 128U, UINT8_MAX-1U, UINT8_MAX };
+  for (uint8_t a=0; a<sizeof(dividends)/sizeof(dividends[0]); ++a) {
+    for (uint8_t b=0; b<sizeof(values)/sizeof(values[0]); ++b) {
+      for (uint8_t c=0; c<sizeof(values)/sizeof(values[0]); ++c) {
+        assert_fastmuldiv(dividends[a], values[b], values[c]);
+      }
+    }
+  }
+  // Either side of the quotient fitting: the product's upper byte is divisor-1 or divisor
+  assert_fastmuldiv<uint8_t, uint8_t>(UINT16_MAX, UINT8_MAX, UINT8_MAX-1U);
+  assert_fastmuldiv<uint8_t, uint8_t>(UINT16_MAX, UINT8_MAX, UINT8_MAX);
+  assert_fastmuldiv<uint8_t, uint8_t>(32768U, 4U, 2U);
+  assert_fastmuldiv<uint8_t, uint8_t>(32768U, 4U, 3U);
+#if defined(USE_OPTIMIZED_DIV)
+  TEST_ASSERT_EQUAL_UINT16(0U, fast_muldiv((uint16_t)UINT16_MAX, (uint8_t)UINT8_MAX, (uint8_t)0U));
+  TEST_ASSERT_EQUAL_UINT16(0U, fast_muldiv_sat((uint16_t)UINT16_MAX, (uint8_t)UINT8_MAX, (uint8_t)0U));
+#endif
+}
+
+// Wrap up the assertion that ((wide)a << N)/b==fast_div_fixed<N>(a,b)
+template <uint8_t N, typename TDividend, typename TDivisor>
+static void assert_fastdivfixed(TDividend dividend, TDivisor divisor) {
+  using result_t = decltype(fast_div_fixed<N>(dividend, divisor));
+  const result_t expected = (result_t)((result_t)dividend * ((result_t)1 << N)) / divisor;
+  result_t actual = fast_div_fixed<N>(dividend, divisor);
+
+  char msgBuffer[256];
+  sprintf(msgBuffer, "%s: %" PRId32 ", %" PRId32, __PRETTY_FUNCTION__, (int32_t)dividend, (int32_t)divisor);
+  if (sizeof(result_t)>sizeof(uint32_t)) {
+#if defined(UNITY_SUPPORT_64)
+    TEST_ASSERT_EQUAL_INT64_MESSAGE(expected, actual, msgBuffer);
+#endif
+  } else {
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(expected, actual, msgBuffer);
+  }
+}
+
+template <uint8_t N, typename TDividend, typename TDivisor, size_t DividendCount, size_t DivisorCount>
+static void assert_fastdivfixed_table(const TDividend (&dividends)[DividendCount], const TDivisor (&divisors)[DivisorCount]) {
+  for (uint8_t dividendIndex=0; dividendIndex<DividendCount; ++dividendIndex) {
+    for (uint8_t divisorIndex=0; divisorIndex<DivisorCount; ++divisorIndex) {
+      assert_fastdivfixed<N>(dividends[dividendIndex], divisors[divisorIndex]);
+    }
+  }
+}
+
+static void test_fast_div_fixed_u16(void) {
+  static const uint16_t dividends[] = { 0U, 1U, 127U, 128U, 255U, 256U, 1000U, 32767U, 32768U, UINT16_MAX };
+  static const uint8_t divisors8[] = { 1U, 2U, 3U, 100U, 128U, UINT8_MAX };
+  static const uint16_t divisors16[] = { 1U, 3U, 255U, 256U, 1000U, 32768U, UINT16_MAX };
+  assert_fastdivfixed_table<0>(dividends, divisors8);
+  assert_fastdivfixed_table<1>(dividends, divisors8);
+  assert_fastdivfixed_table<8>(dividends, divisors8);
+  assert_fastdivfixed_table<12>(dividends, divisors8);
+  assert_fastdivfixed_table<16>(dividends, divisors8);
+  assert_fastdivfixed_table<0>(dividends, divisors16);
+  assert_fastdivfixed_table<8>(dividends, divisors16);
+  assert_fastdivfixed_table<15>(dividends, divisors16);
+  assert_fastdivfixed_table<16>(dividends, divisors16);
+}
+
+static void test_fast_div_fixed_s16(void) {
+  static const int16_t dividends[] = { INT16_MIN, INT16_MIN+1, -1000, -1, 0, 1, 127, 1000, INT16_MAX };
+  static const int8_t divisors8[] = { INT8_MIN, -3, -1, 1, 7, INT8_MAX };
+  static const int16_t divisors16[] = { INT16_MIN, -1000, -1, 1, 3, 1000, INT16_MAX };
+  assert_fastdivfixed_table<8>(dividends, divisors8);
+  assert_fastdivfixed_table<15>(dividends, divisors8);
+  assert_fastdivfixed_table<8>(dividends, divisors16);
+  assert_fastdivfixed_table<15>(dividends, divisors16);
+}
+
+#if defined(UNITY_SUPPORT_64)
+static void test_fast_div_fixed_u32(void) {
+  static const uint32_t dividends[] = { 0U, 1U, 255U, UINT16_MAX, UINT16_MAX+1UL, 60000000UL, 0x7FFFFFFFUL, UINT32_MAX };
+  static const uint8_t divisors8[] = { 1U, 3U, UINT8_MAX };
+  static const uint16_t divisors16[] = { 1U, 7U, 1000U, UINT16_MAX };
+  static const uint32_t divisors32[] = { 1U, 3U, UINT16_MAX, UINT16_MAX+1UL, 60000000UL, UINT32_MAX };
+  assert_fastdivfixed_table<8>(dividends, divisors8);
+  assert_fastdivfixed_table<16>(dividends, divisors16);
+  assert_fastdivfixed_table<24>(dividends, divisors16);
+  assert_fastdivfixed_table<0>(dividends, divisors32);
+  assert_fastdivfixed_table<16>(dividends, divisors32);
+  assert_fastdivfixed_table<31>(dividends, divisors32);
+  assert_fastdivfixed_table<32>(dividends, divisors32);
+}
+
+static void test_fast_div_fixed_s32(void) {
+  static const int32_t dividends[] = { INT32_MIN, INT32_MIN+1, -60000000L, -1, 0, 1, 60000000L, INT32_MAX };
+  static const int16_t divisors16[] = { INT16_MIN, -7, 1, 1000, INT16_MAX };
+  static const int32_t divisors32[] = { INT32_MIN, -100000L, -1, 1, 3, INT32_MAX };
+  assert_fastdivfixed_table<16>(dividends, divisors16);
+  assert_fastdivfixed_table<16>(dividends, divisors32);
+  assert_fastdivfixed_table<31>(dividends, divisors32);
+}
+#endif
+
+static void test_fast_div_fixed(void) {
+  RUN_TEST(test_fast_div_fixed_u16);
+  RUN_TEST(test_fast_div_fixed_s16);
+#if defined(UNITY_SUPPORT_64)
+  RUN_TEST(test_fast_div_fixed_u32);
+  RUN_TEST(test_fast_div_fixed_s32);
+#endif
+}
+
+static void test_fast_muldiv(void) {
+  RUN_TEST(test_fast_muldiv_u16_u16);
+  RUN_TEST(test_fast_muldiv_u16_u8);
+}
+
+#if defined(AFD_BACKEND_RP2040)
+#include "hardware/divider.h"
+
+// An ISR that divides while other code is mid division (between writing the 
+// operands & reading the quotient) must leave that division intact
+static void test_fast_div_interrupts_sio(void) {
+  hw_divider_divmod_u32_start(1000000UL, 7U);
+  // As if from an ISR: the large divisor & narrow kernels both use the divider
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX/100000UL, fast_div(UINT32_MAX, (uint32_t)100000UL));
+  TEST_ASSERT_EQUAL_UINT16(1000000UL/1000U, fast_div((uint32_t)1000000UL, (uint16_t)1000U));
+  TEST_ASSERT_EQUAL_UINT32(1000000UL%7U, hw_divider_u32_remainder_wait());
+  TEST_ASSERT_EQUAL_UINT32(1000000UL/7U, hw_divider_u32_quotient_wait());
+}
+#endif
+
 void test_fast_div(void) {
     SET_UNITY_FILENAME() {
         test_fast_div_8();
         test_fast_div_16();
         test_fast_div_32();
+#if defined(AFD_HAS_INT24)
+        test_fast_div_24();
+#endif
+#if defined(UNITY_SUPPORT_64)
+        test_fast_div_64();
+#endif
+        test_fast_muldiv();
+        test_fast_div_fixed();
+#if defined(AFD_BACKEND_RP2040)
+        RUN_TEST(test_fast_div_interrupts_sio);
+#endif
     }
 }
\ No newline at end of file
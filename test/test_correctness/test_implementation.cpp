@@ -21,6 +21,10 @@ static void assert_divide_u32u16(uint32_t dividend, uint16_t divisor) {
   auto native = dividend / divisor;
   uint16_t optimised = avr_fast_div_impl::divide(dividend, divisor);
   TEST_ASSERT_EQUAL_UINT32_MESSAGE(native, optimised, msgBuffer);
+
+  afd_divmod_t<uint16_t, uint16_t> divmod = avr_fast_div_impl::divmod(dividend, divisor);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(native, divmod.quot, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend % divisor, divmod.rem, msgBuffer);
 }
 
 static void test_divide_u32u16(void)
@@ -50,6 +54,10 @@ static void assert_divide_u16u8(uint16_t dividend, uint8_t divisor) {
   auto native = dividend / divisor;
   auto optimised = avr_fast_div_impl::divide(dividend, divisor);
   TEST_ASSERT_EQUAL_UINT16_MESSAGE(native, optimised, msgBuffer);
+
+  afd_divmod_t<uint8_t, uint8_t> divmod = avr_fast_div_impl::divmod(dividend, divisor);
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE(native, divmod.quot, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE(dividend % divisor, divmod.rem, msgBuffer);
 }
 
 static void test_divide_u16u8(void)
@@ -71,6 +79,133 @@ static void test_divide_u16u8(void)
   assert_divide_u16u8(UINT8_MAX*7-1, 7); 
 }
 
+static void assert_divide_u64u32(uint64_t dividend, uint32_t divisor) {
+  char msgBuffer[128];
+  sprintf(msgBuffer, "0x%08" PRIX32 "%08" PRIX32 ", %" PRIu32, (uint32_t)(dividend >> 32U), (uint32_t)dividend, divisor);
+
+  // This is here to prevent a bad test: the implementation doesn't handle the
+  // case where the quotient doesn't fit into a uint32_t
+  TEST_ASSERT_GREATER_THAN_MESSAGE((uint32_t)(dividend >> 32U), divisor, msgBuffer);
+
+  auto native = dividend / divisor;
+  afd_divmod_t<uint32_t, uint32_t> divmod = avr_fast_div_impl::divmod(dividend, divisor);
+  TEST_ASSERT_EQUAL_UINT64_MESSAGE(native, divmod.quot, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT64_MESSAGE(dividend % divisor, divmod.rem, msgBuffer);
+}
+
+static void test_divide_u64u32(void)
+{
+  assert_divide_u64u32(1, 1);
+  assert_divide_u64u32(UINT64_MAX/2ULL, UINT32_MAX);
+  assert_divide_u64u32((uint64_t)UINT32_MAX+1ULL, UINT32_MAX);
+  assert_divide_u64u32((uint64_t)UINT32_MAX-1ULL, UINT32_MAX);
+  assert_divide_u64u32((uint64_t)UINT32_MAX*3U, (UINT32_MAX/4U)*3U);
+  assert_divide_u64u32(86400000000ULL, 1000000UL);  // 1 day in microseconds
+  assert_divide_u64u32(0x123456789ABCDEF0ULL, 0x87654321UL);
+}
+
+static void assert_divide_narrow_u32u8(uint32_t dividend, uint8_t divisor) {
+  char msgBuffer[128];
+  sprintf(msgBuffer, "%" PRIu32 ", %" PRIu8, dividend, divisor);
+
+  // This is here to prevent a bad test: the implementation doesn't handle the
+  // case where the quotient doesn't fit into 24-bits
+  TEST_ASSERT_GREATER_THAN_MESSAGE((uint8_t)(dividend >> 24U), divisor, msgBuffer);
+
+  const uint32_t remQuot = avr_fast_div_impl::divide_rem_quot_bytes<3U>(dividend, divisor);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend / divisor, remQuot & 0x00FFFFFFUL, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend % divisor, remQuot >> 24U, msgBuffer);
+
+  if ((dividend >> 8U) < divisor) {
+    afd_divmod_t<uint8_t, uint8_t> divmod = avr_fast_div_impl::divmod_narrow<uint8_t>(dividend, divisor);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend / divisor, divmod.quot, msgBuffer);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend % divisor, divmod.rem, msgBuffer);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend / divisor, avr_fast_div_impl::divide_narrow<uint8_t>(dividend, divisor), msgBuffer);
+  }
+}
+
+static void test_divide_narrow_u32u8(void)
+{
+  assert_divide_narrow_u32u8(1, 1);
+  assert_divide_narrow_u32u8(UINT8_MAX, 1);
+  assert_divide_narrow_u32u8(UINT16_MAX-UINT8_MAX-1U, UINT8_MAX);  // Largest u8 quotient
+  assert_divide_narrow_u32u8(0x00FFFFFFUL, 1);
+  assert_divide_narrow_u32u8(0xFEFFFFFFUL, UINT8_MAX);  // Largest u24 quotient
+  assert_divide_narrow_u32u8(MICROS_PER_MIN, 60U);
+  assert_divide_narrow_u32u8(MICROS_PER_HOUR, 251U);
+}
+
+#if defined(AFD_HAS_INT24)
+static void assert_divide_narrow_u32u16(uint32_t dividend, uint16_t divisor) {
+  char msgBuffer[128];
+  sprintf(msgBuffer, "%" PRIu32 ", %" PRIu16, dividend, divisor);
+
+  // This is here to prevent a bad test: the implementation doesn't handle the
+  // case where the quotient doesn't fit into a uint8_t
+  TEST_ASSERT_GREATER_THAN_MESSAGE(dividend >> 8U, divisor, msgBuffer);
+
+  afd_divmod_t<uint8_t, uint16_t> divmod = avr_fast_div_impl::divmod_narrow<uint8_t>(dividend, divisor);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend / divisor, divmod.quot, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend % divisor, divmod.rem, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend / divisor, avr_fast_div_impl::divide_narrow<uint8_t>(dividend, divisor), msgBuffer);
+}
+
+static void test_divide_narrow_u32u16(void)
+{
+  assert_divide_narrow_u32u16(1, 1);
+  assert_divide_narrow_u32u16(UINT8_MAX, 1);
+  assert_divide_narrow_u32u16(0x00FFFEFFUL, UINT16_MAX);  // Largest u8 quotient
+  assert_divide_narrow_u32u16(MICROS_PER_SEC, 4000U);
+  assert_divide_narrow_u32u16(MICROS_PER_SEC, 3922U);
+}
+#endif
+
+#if defined(AFD_HAS_INT24)
+static void assert_divide_u24u8(__uint24 dividend, uint8_t divisor) {
+  char msgBuffer[128];
+  sprintf(msgBuffer, "%" PRIu32 ", %" PRIu8, (uint32_t)dividend, divisor);
+
+  // This is here to prevent a bad test: the implementation doesn't handle the
+  // case where the quotient doesn't fit into a uint16_t
+  TEST_ASSERT_GREATER_THAN_MESSAGE((uint8_t)(dividend >> 16U), divisor, msgBuffer);
+
+  afd_divmod_t<uint16_t, uint8_t> divmod = avr_fast_div_impl::divmod(dividend, divisor);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend / divisor, divmod.quot, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend % divisor, divmod.rem, msgBuffer);
+}
+
+static void test_divide_u24u8(void)
+{
+  assert_divide_u24u8(1, 1);
+  assert_divide_u24u8(UINT16_MAX, 1);
+  assert_divide_u24u8(__UINT24_MAX__/2U, UINT8_MAX);
+  assert_divide_u24u8((__uint24)UINT16_MAX+1U, 2);
+  assert_divide_u24u8(3600000UL, 60U);
+}
+
+static void assert_divide_u24u16(__uint24 dividend, uint16_t divisor) {
+  char msgBuffer[128];
+  sprintf(msgBuffer, "%" PRIu32 ", %" PRIu16, (uint32_t)dividend, divisor);
+
+  // This is here to prevent a bad test: the implementation doesn't handle the
+  // case where the quotient doesn't fit into a uint8_t
+  TEST_ASSERT_GREATER_THAN_MESSAGE((uint16_t)(dividend >> 8U), divisor, msgBuffer);
+
+  afd_divmod_t<uint8_t, uint16_t> divmod = avr_fast_div_impl::divmod(dividend, divisor);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend / divisor, divmod.quot, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend % divisor, divmod.rem, msgBuffer);
+}
+
+static void test_divide_u24u16(void)
+{
+  assert_divide_u24u16(1, 1);
+  assert_divide_u24u16(UINT8_MAX, 1);
+  assert_divide_u24u16(__UINT24_MAX__/2U, UINT16_MAX);
+  assert_divide_u24u16(UINT16_MAX, UINT8_MAX+1U);
+  assert_divide_u24u16(3600000UL, 60000U);
+}
+#endif
+
 template <typename T>
 static void assert_divide_large_divisor(T dividend, T divisor) {
   auto native = dividend / divisor;
@@ -78,6 +213,10 @@ static void assert_divide_large_divisor(T dividend, T divisor) {
   char msgBuffer[128];
   sprintf(msgBuffer, "%" PRIu32", %" PRIu32, (uint32_t)dividend, (uint32_t)divisor);
   TEST_ASSERT_EQUAL_UINT32_MESSAGE(native, optimised, msgBuffer);
+
+  afd_divmod_t<T, T> divmod = avr_fast_div_impl::divmod_large_divisor(dividend, divisor);
+  TEST_ASSERT_EQUAL_UINT64_MESSAGE(native, divmod.quot, msgBuffer);
+  TEST_ASSERT_EQUAL_UINT64_MESSAGE(dividend % divisor, divmod.rem, msgBuffer);
 }
 
 
@@ -88,23 +227,67 @@ static void test_divide_large_divisor_u32u32(void) {
   assert_divide_large_divisor<uint32_t>(UINT32_MAX, UINT16_MAX+1UL);
   assert_divide_large_divisor<uint32_t>(UINT32_MAX, UINT32_MAX/2U);
   assert_divide_large_divisor<uint32_t>(UINT32_MAX, UINT32_MAX);
+  // Byte alignment boundaries
+  assert_divide_large_divisor<uint32_t>(0x00FFFFFFUL, 0x01000000UL);
+  assert_divide_large_divisor<uint32_t>(0x01000000UL, 0x00FFFFFFUL);
+  assert_divide_large_divisor<uint32_t>(UINT32_MAX, 0x01000000UL);
+  assert_divide_large_divisor<uint32_t>(0x12345678UL, 0x00123456UL);
+  assert_divide_large_divisor<uint32_t>(0x80000000UL, 0x80000001UL);
 
   TEST_ASSERT_EQUAL_UINT32(avr_fast_div_impl::divide_large_divisor<uint32_t>(UINT16_MAX, 1), 0);
   TEST_ASSERT_EQUAL_UINT32(avr_fast_div_impl::divide_large_divisor<uint32_t>(UINT16_MAX, UINT16_MAX-1U), 0);
   TEST_ASSERT_EQUAL_UINT32(avr_fast_div_impl::divide_large_divisor<uint32_t>(UINT16_MAX, UINT16_MAX), 0);
 }
 
+static void test_divide_large_divisor_u64u64(void) {
+  TEST_ASSERT_EQUAL_UINT32(avr_fast_div_impl::divide_large_divisor<uint64_t>(UINT64_MAX, UINT32_MAX), 0);
+  assert_divide_large_divisor<uint64_t>(UINT64_MAX, (uint64_t)UINT32_MAX+1ULL);
+  assert_divide_large_divisor<uint64_t>(UINT64_MAX, UINT64_MAX/2U);
+  assert_divide_large_divisor<uint64_t>(UINT64_MAX, UINT64_MAX);
+  assert_divide_large_divisor<uint64_t>(0x123456789ABCDEF0ULL, 0x123456789ULL);
+  assert_divide_large_divisor<uint64_t>(0x123456789ULL, 0x123456789ABCDEF0ULL);
+}
+
 static void test_divide_large_divisor_u16u16(void) {
   TEST_ASSERT_EQUAL_UINT32(avr_fast_div_impl::divide_large_divisor<uint16_t>(UINT16_MAX, 1), 0);
   TEST_ASSERT_EQUAL_UINT32(avr_fast_div_impl::divide_large_divisor<uint16_t>(UINT16_MAX, UINT8_MAX), 0);
   assert_divide_large_divisor<uint16_t>(UINT16_MAX, UINT8_MAX+1UL);
   assert_divide_large_divisor<uint16_t>(UINT16_MAX, UINT16_MAX/2);
   assert_divide_large_divisor<uint16_t>(UINT16_MAX, UINT16_MAX);
+  // Byte alignment boundaries
+  assert_divide_large_divisor<uint16_t>(0x00FFU, 0x0100U);
+  assert_divide_large_divisor<uint16_t>(0x1234U, 0x0123U);
+  assert_divide_large_divisor<uint16_t>(0x8000U, 0x8001U);
 
   TEST_ASSERT_EQUAL_UINT32(avr_fast_div_impl::divide_large_divisor<uint16_t>(UINT8_MAX, 1), 0);
   TEST_ASSERT_EQUAL_UINT32(avr_fast_div_impl::divide_large_divisor<uint16_t>(UINT8_MAX, UINT8_MAX-1U), 0);
   TEST_ASSERT_EQUAL_UINT32(avr_fast_div_impl::divide_large_divisor<uint16_t>(UINT8_MAX, UINT8_MAX), 0);
 }
+
+template <typename T>
+static void assert_align(T reference, T dependent) {
+  char msgBuffer[128];
+  sprintf(msgBuffer, "%" PRIu32", %" PRIu32, (uint32_t)reference, (uint32_t)dependent);
+  const T original = dependent;
+  T bit = avr_fast_div_impl::align(reference, dependent);
+  TEST_ASSERT_TRUE_MESSAGE(avr_fast_div_impl::is_aligned(reference, dependent), msgBuffer);
+  TEST_ASSERT_TRUE_MESSAGE(dependent<=reference, msgBuffer);
+  TEST_ASSERT_TRUE_MESSAGE((T)(original*bit)==dependent, msgBuffer);
+}
+
+static void test_align(void) {
+  assert_align<uint16_t>(UINT16_MAX, 1U);
+  assert_align<uint16_t>(UINT16_MAX, UINT16_MAX);
+  assert_align<uint16_t>(0x0100U, 0x0001U);
+  assert_align<uint16_t>(0x00FFU, 0x0001U);
+  assert_align<uint32_t>(UINT32_MAX, 1U);
+  assert_align<uint32_t>(UINT32_MAX, UINT16_MAX+1UL);
+  assert_align<uint32_t>(0x01000000UL, 0x00000001UL);
+  assert_align<uint32_t>(0x00FFFFFFUL, 0x00000001UL);
+  assert_align<uint32_t>(0x12345678UL, 0x00012345UL);
+  assert_align<uint64_t>(UINT64_MAX, 1U);
+  assert_align<uint64_t>(0x123456789ABCDEF0ULL, 0x123456789ULL);
+}
 #endif
 
 void test_implementation_details(void) {
@@ -112,8 +295,19 @@ void test_implementation_details(void) {
    SET_UNITY_FILENAME() {
         RUN_TEST(test_divide_u32u16);
         RUN_TEST(test_divide_u16u8);
+        RUN_TEST(test_divide_u64u32);
+        RUN_TEST(test_divide_narrow_u32u8);
+#if defined(AFD_HAS_INT24)
+        RUN_TEST(test_divide_narrow_u32u16);
+#endif
+#if defined(AFD_HAS_INT24)
+        RUN_TEST(test_divide_u24u8);
+        RUN_TEST(test_divide_u24u16);
+#endif
         RUN_TEST(test_divide_large_divisor_u32u32);
         RUN_TEST(test_divide_large_divisor_u16u16);
+        RUN_TEST(test_divide_large_divisor_u64u64);
+        RUN_TEST(test_align);
     }
 #endif
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "avr-fast-div.h"
+#include "afd_implementation.hpp"
+
+#if defined(AFD_NEWTON_RAPHSON)
+
+// The uint32_t reciprocal is built from 16x16=>32 partial products, so the carry
+// boundaries are the normalized extremes: the top bit only (2^15, 2^31), all
+// ones, & the digits either side of those.
+
+template <typename T, size_t N>
+static constexpr size_t array_size(const T (&)[N]) {
+  return N;
+}
+
+// The sweeps assert once, not per case: a Unity call per case would dominate
+// the run time on simavr.
+struct nr_failures_t {
+  uint32_t count;
+  uint32_t firstDividend;
+  uint32_t firstDivisor;
+};
+
+static void record_failure(nr_failures_t &failures, uint32_t dividend, uint32_t divisor) {
+  if (failures.count==0U) {
+    failures.firstDividend = dividend;
+    failures.firstDivisor = divisor;
+  }
+  ++failures.count;
+}
+
+static void assert_no_failures(const nr_failures_t &failures) {
+  char msgBuffer[96];
+  sprintf(msgBuffer, "%" PRIu32 " failures, first %" PRIu32 ", %" PRIu32, failures.count, failures.firstDividend, failures.firstDivisor);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0U, failures.count, msgBuffer);
+}
+
+// Every normalized word: the 2 Newton-Raphson iterations must land on the exact
+// floor((2^32-1)/d1)-2^16. I.e. (2^16+v)*d1 <= 2^32-1 < (2^16+v+1)*d1
+static void test_reciprocal_digit_u16(void) {
+  nr_failures_t failures = { 0U, 0U, 0U };
+  uint16_t d1 = 0x8000U;
+  do {
+    const uint64_t v = (uint64_t)avr_fast_div_impl::reciprocal_digit(d1) + 0x10000U;
+    if ((v*d1)>UINT32_MAX || ((v+1U)*d1)<=UINT32_MAX) {
+      record_failure(failures, 0U, d1);
+    }
+  } while (++d1!=0U);
+  assert_no_failures(failures);
+}
+
+// Every normalized uint16_t divisor: floor((2^24-1)/d)-2^8
+static void test_reciprocal_3by2_u8(void) {
+  nr_failures_t failures = { 0U, 0U, 0U };
+  for (uint16_t d1=0x80U; d1<=UINT8_MAX; ++d1) {
+    uint8_t d0 = 0U;
+    do {
+      const uint32_t divisor = ((uint32_t)d1 << 8U) | d0;
+      const uint8_t expected = (uint8_t)((0xFFFFFFUL / divisor) - 0x100UL);
+      if (avr_fast_div_impl::reciprocal_3by2((uint8_t)d1, d0)!=expected) {
+        record_failure(failures, 0U, divisor);
+      }
+    } while (++d0!=0U);
+  }
+  assert_no_failures(failures);
+}
+
+static void assert_reciprocal_3by2_u16(uint16_t d1, uint16_t d0) {
+  const uint64_t divisor = ((uint64_t)d1 << 16U) | d0;
+  const uint64_t expected = (0xFFFFFFFFFFFFULL / divisor) - 0x10000ULL;
+  char msgBuffer[32];
+  sprintf(msgBuffer, "%" PRIu16 ":%" PRIu16, d1, d0);
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE((uint16_t)expected, avr_fast_div_impl::reciprocal_3by2(d1, d0), msgBuffer);
+}
+
+// floor((2^48-1)/d)-2^16, for each pair of boundary digits (d1 normalized)
+static void test_reciprocal_3by2_u16(void) {
+  static const uint16_t digits[] = { 0x0000U, 0x0001U, 0x7FFFU, 0x8000U, 0x8001U, 0xFFFEU, 0xFFFFU };
+  for (size_t d1Index=0U; d1Index<array_size(digits); ++d1Index) {
+    if (digits[d1Index]>=0x8000U) {
+      for (size_t d0Index=0U; d0Index<array_size(digits); ++d0Index) {
+        assert_reciprocal_3by2_u16(digits[d1Index], digits[d0Index]);
+      }
+    }
+  }
+}
+
+template <typename T>
+static bool check_divmod_reciprocal_3by2(T dividend, T divisor) {
+  const afd_divmod_t<T, T> result = avr_fast_div_impl::divmod_reciprocal_3by2(dividend, divisor);
+  return result.quot==(T)(dividend/divisor) && result.rem==(T)(dividend%divisor);
+}
+
+// divide_3by2() via divmod_reciprocal_3by2(): each divisor by every dividend.
+// The smallest large divisors (the largest normalization shifts) & the
+// extremes without a shift. 260 needs the rare second correction (E.g. 49660/260)
+static void test_divide_3by2_u16(void) {
+  static const uint16_t divisors[] = { 0x0100U, 0x0104U, 0x01FFU, 0x7FFFU, 0x8000U, 0x8001U, 0xFFFFU };
+  nr_failures_t failures = { 0U, 0U, 0U };
+  for (size_t divisorIndex=0U; divisorIndex<array_size(divisors); ++divisorIndex) {
+    uint16_t dividend = 0U;
+    do {
+      if (!check_divmod_reciprocal_3by2(dividend, divisors[divisorIndex])) {
+        record_failure(failures, dividend, divisors[divisorIndex]);
+      }
+    } while (++dividend!=0U);
+  }
+  assert_no_failures(failures);
+}
+
+static void sweep_divmod_reciprocal_3by2(nr_failures_t &failures, uint32_t dividend, uint32_t divisor) {
+  if (!check_divmod_reciprocal_3by2(dividend, divisor)) {
+    record_failure(failures, dividend, divisor);
+  }
+}
+
+// As above, for uint32_t: boundary dividends, plus either side of multiples of
+// the divisor (which exercise the estimate's correction steps)
+static void test_divide_3by2_u32(void) {
+  static const uint32_t divisors[] = { 0x00010000UL, 0x0001FFFFUL, 0x7FFFFFFFUL, 0x80000000UL, 0x80000001UL,
+                                       0x8000FFFFUL, 0xFFFF0000UL, 0xFFFFFFFEUL, UINT32_MAX };
+  static const uint32_t dividends[] = { 0UL, 1UL, 0x0000FFFFUL, 0x00010000UL, 0x7FFFFFFFUL, 0x80000000UL,
+                                        0x80000001UL, 0xFFFF0000UL, 0xFFFFFFFEUL, UINT32_MAX };
+  nr_failures_t failures = { 0U, 0U, 0U };
+  for (size_t divisorIndex=0U; divisorIndex<array_size(divisors); ++divisorIndex) {
+    const uint32_t divisor = divisors[divisorIndex];
+    for (size_t dividendIndex=0U; dividendIndex<array_size(dividends); ++dividendIndex) {
+      sweep_divmod_reciprocal_3by2(failures, dividends[dividendIndex], divisor);
+    }
+    const uint32_t maxMultiple = UINT32_MAX/divisor;
+    for (uint32_t multiple=1U; multiple<=maxMultiple; multiple = (multiple<<1U)|1U) {
+      sweep_divmod_reciprocal_3by2(failures, multiple*divisor-1U, divisor);
+      sweep_divmod_reciprocal_3by2(failures, multiple*divisor, divisor);
+      sweep_divmod_reciprocal_3by2(failures, multiple*divisor+(multiple==maxMultiple ? 0U : 1U), divisor);
+    }
+    sweep_divmod_reciprocal_3by2(failures, maxMultiple*divisor-1U, divisor);
+    sweep_divmod_reciprocal_3by2(failures, maxMultiple*divisor, divisor);
+  }
+  // These need the rare second correction
+  sweep_divmod_reciprocal_3by2(failures, 3072327381UL, 72692UL);
+  sweep_divmod_reciprocal_3by2(failures, 4229955396UL, 524483UL);
+  sweep_divmod_reciprocal_3by2(failures, 3040864255UL, 2102949UL);
+  assert_no_failures(failures);
+}
+#endif
+
+void test_newton_raphson(void) {
+    SET_UNITY_FILENAME() {
+#if defined(AFD_NEWTON_RAPHSON)
+        RUN_TEST(test_reciprocal_digit_u16);
+        RUN_TEST(test_reciprocal_3by2_u8);
+        RUN_TEST(test_reciprocal_3by2_u16);
+        RUN_TEST(test_divide_3by2_u16);
+        RUN_TEST(test_divide_3by2_u32);
+#endif
+    }
+}
@@ -0,0 +1,118 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "avr-fast-div.h"
+#include "afd_implementation.hpp"
+
+#if defined(AFD_RECIPROCAL_TABLE)
+
+// Checking q*d <= n < (q+1)*d needs a multiply rather than a reference division,
+// so an exhaustive sweep stays affordable on simavr. One assert per divisor: a
+// Unity call per case would dominate the run time.
+struct reciprocal_failures_t {
+  uint32_t count;
+  uint16_t firstDividend;
+};
+
+static void record_failure(reciprocal_failures_t &failures, uint16_t dividend) {
+  if (failures.count==0U) {
+    failures.firstDividend = dividend;
+  }
+  ++failures.count;
+}
+
+static void assert_no_failures(const reciprocal_failures_t &failures, const char *pCheck, uint8_t divisor) {
+  char msgBuffer[96];
+  sprintf(msgBuffer, "%s: %" PRIu32 " failures, first %" PRIu16 "/%" PRIu8, pCheck, failures.count, failures.firstDividend, divisor);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0U, failures.count, msgBuffer);
+}
+
+// divmod_reciprocal() corrects its estimate at most once. That is only correct
+// if, for every 16-bit dividend, floor(n*entry/2^16) is n/d or n/d-1:
+// i.e. n-estimate*d is in [0, 2*d). Check that bound for every table entry,
+// before the correction step.
+static void test_reciprocal_single_correction(void) {
+  for (uint16_t divisor=1U; divisor<=UINT8_MAX; ++divisor) {
+    const uint16_t reciprocal = avr_fast_div_impl::read_reciprocal((uint8_t)divisor);
+    reciprocal_failures_t failures = { 0U, 0U };
+    uint16_t dividend = 0U;
+    do {
+      const uint16_t estimate = (uint16_t)(avr_fast_div_impl::multiply(dividend, reciprocal) >> 16U);
+      const uint32_t product = (uint32_t)estimate * divisor;
+      if (product>dividend || (dividend-product)>=(2U*divisor)) {
+        record_failure(failures, dividend);
+      }
+    } while (++dividend!=0U);
+    assert_no_failures(failures, "estimate", (uint8_t)divisor);
+  }
+}
+
+// Every uint16_t/uint8_t division. This also covers each step of the
+// uint32_t/uint8_t long division, since those are 16-bit divmod_reciprocal() calls
+static void test_reciprocal_exhaustive_u16_u8(void) {
+  for (uint16_t divisor=1U; divisor<=UINT8_MAX; ++divisor) {
+    reciprocal_failures_t failures = { 0U, 0U };
+    uint16_t dividend = 0U;
+    do {
+      const uint16_t quot = fast_div(dividend, (uint8_t)divisor);
+      const uint32_t product = (uint32_t)quot * divisor;
+      if (product>dividend || (dividend-product)>=divisor) {
+        record_failure(failures, dividend);
+      }
+    } while (++dividend!=0U);
+    assert_no_failures(failures, "fast_div", (uint8_t)divisor);
+  }
+}
+
+static void assert_reciprocal_u32_u8(uint32_t dividend, uint8_t divisor) {
+  char msgBuffer[64];
+  sprintf(msgBuffer, "%" PRIu32 ", %" PRIu8, dividend, divisor);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(dividend/divisor, fast_div(dividend, divisor), msgBuffer);
+}
+
+// The largest dividend where each of the 3 long division steps leaves a
+// remainder of divisor-1: the middle & lower steps then see their largest
+// 16-bit dividends, (divisor-1)*256+byte.
+static uint32_t max_remainders_dividend(uint8_t divisor) {
+  const uint8_t maxRem = (uint8_t)(divisor-1U);
+  const uint16_t upper = (uint16_t)(UINT16_MAX - ((UINT16_MAX-maxRem) % divisor));
+  const uint16_t stepMax = (uint16_t)(((uint16_t)maxRem << 8U) | UINT8_MAX);
+  const uint8_t next = (uint8_t)(UINT8_MAX - ((stepMax-maxRem) % divisor));
+  return ((uint32_t)upper << 16U) | ((uint32_t)next << 8U) | next;
+}
+
+// The uint32_t/uint8_t long division carries a remainder between its 3 steps:
+// dividends either side of the byte & word boundaries, & of multiples of the
+// divisor at those boundaries.
+static void test_reciprocal_boundary_u32_u8(void) {
+  for (uint16_t divisor=1U; divisor<=UINT8_MAX; ++divisor) {
+    const uint8_t udivisor = (uint8_t)divisor;
+    assert_reciprocal_u32_u8(0U, udivisor);
+    assert_reciprocal_u32_u8(udivisor-1U, udivisor);
+    assert_reciprocal_u32_u8(udivisor, udivisor);
+    assert_reciprocal_u32_u8(UINT16_MAX, udivisor);
+    assert_reciprocal_u32_u8((uint32_t)UINT16_MAX+1U, udivisor);
+    assert_reciprocal_u32_u8(((uint32_t)udivisor << 16U)-1U, udivisor);
+    assert_reciprocal_u32_u8((uint32_t)udivisor << 16U, udivisor);
+    assert_reciprocal_u32_u8(0x00FFFFFFUL, udivisor);
+    assert_reciprocal_u32_u8(0x01000000UL, udivisor);
+    assert_reciprocal_u32_u8(((uint32_t)udivisor << 24U)-1U, udivisor);
+    assert_reciprocal_u32_u8((uint32_t)udivisor << 24U, udivisor);
+    assert_reciprocal_u32_u8(max_remainders_dividend(udivisor), udivisor);
+    assert_reciprocal_u32_u8(((UINT32_MAX/udivisor)*udivisor)-1U, udivisor);
+    assert_reciprocal_u32_u8((UINT32_MAX/udivisor)*udivisor, udivisor);
+    assert_reciprocal_u32_u8(UINT32_MAX-1U, udivisor);
+    assert_reciprocal_u32_u8(UINT32_MAX, udivisor);
+  }
+}
+#endif
+
+void test_reciprocal_table(void) {
+    SET_UNITY_FILENAME() {
+#if defined(AFD_RECIPROCAL_TABLE)
+        RUN_TEST(test_reciprocal_single_correction);
+        RUN_TEST(test_reciprocal_exhaustive_u16_u8);
+        RUN_TEST(test_reciprocal_boundary_u32_u8);
+#endif
+    }
+}
@@ -0,0 +1,10 @@
+#include <unity.h>
+
+extern void test_native_sweep(void);
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    test_native_sweep();
+    return UNITY_END();
+}
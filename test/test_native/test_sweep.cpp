@@ -0,0 +1,300 @@
+#include <unity.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include "avr-fast-div.h"
+
+// Dense correctness sweeps, far beyond what simavr can run at 16MHz. The library
+// is built with AFD_C_MODEL, so the optimized algorithms run with the assembly
+// kernels replaced by their C models. Or with AFD_BACKEND_ARMV6M under qemu-arm,
+// to run the Thumb kernels. The reference is the compiler's own division.
+
+#if !defined(AFD_C_MODEL) && !defined(AFD_BACKEND_ARMV6M)
+#error "The native tests must be built with AFD_C_MODEL or AFD_BACKEND_ARMV6M"
+#endif
+
+#if !defined(NATIVE_RANDOM_ITERATIONS)
+/// @brief Random cases per overload. The native env raises this to 2^32.
+#define NATIVE_RANDOM_ITERATIONS (1ULL<<24)
+#endif
+
+// Collects mismatches without calling into Unity per case: one assert per sweep
+// keeps billions of cases fast. Only the first failure is described.
+struct sweep_failures_t {
+  uint32_t count;
+  char first[192];
+};
+
+static void record_failure(sweep_failures_t &failures, const char *pFunction,
+                           uint64_t dividend, uint64_t divisor, uint64_t expected, uint64_t actual) {
+  if (failures.count==0U) {
+    snprintf(failures.first, sizeof(failures.first), "%s(%" PRIu64 ", %" PRIu64 "): expected %" PRIu64 ", got %" PRIu64,
+             pFunction, dividend, divisor, expected, actual);
+  }
+  ++failures.count;
+}
+
+static void record_failure(sweep_failures_t &failures, const char *pFunction,
+                           int64_t dividend, int64_t divisor, int64_t expected, int64_t actual) {
+  if (failures.count==0U) {
+    snprintf(failures.first, sizeof(failures.first), "%s(%" PRId64 ", %" PRId64 "): expected %" PRId64 ", got %" PRId64,
+             pFunction, dividend, divisor, expected, actual);
+  }
+  ++failures.count;
+}
+
+template <typename T>
+struct widest {
+  using type = type_traits::conditional_t<type_traits::is_signed<T>::value, int64_t, uint64_t>;
+};
+template <typename T>
+struct widest<const T> : widest<T> { };
+
+// INT_MIN/-1 doesn't fit the type (and traps on x86), so is excluded
+template <typename TDividend, typename TDivisor>
+static bool is_overflow(TDividend dividend, TDivisor divisor) {
+  using unsigned_t = type_traits::make_unsigned_t<TDividend>;
+  return type_traits::is_signed<TDividend>::value 
+      && (divisor==(TDivisor)-1)
+      && (dividend==(TDividend)((unsigned_t)1U << ((sizeof(TDividend)*8U)-1U)));
+}
+
+#define CHECK_RESULT(failures, function, dividend, divisor, expected, actual) \
+  if ((expected)!=(actual)) { \
+    using widest_t = typename widest<decltype(dividend)>::type; \
+    record_failure((failures), (function), (widest_t)(dividend), (widest_t)(divisor), (widest_t)(expected), (widest_t)(actual)); \
+  }
+
+#define ASSERT_NO_FAILURES(failures) \
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0U, (failures).count, (failures).first)
+
+template <typename TDividend, typename TDivisor>
+static void check_div(TDividend dividend, TDivisor divisor, sweep_failures_t &failures) {
+  if (is_overflow(dividend, divisor)) {
+    return;
+  }
+  CHECK_RESULT(failures, "fast_div", dividend, divisor, (TDividend)(dividend/divisor), fast_div(dividend, divisor));
+}
+
+// fast_divmod() & fast_mod() only go up to 32-bits
+template <typename TDividend, typename TDivisor>
+static void check_divmod(TDividend dividend, TDivisor divisor, sweep_failures_t &failures) {
+  if (is_overflow(dividend, divisor)) {
+    return;
+  }
+  check_div(dividend, divisor, failures);
+  const afd_divmod_t<TDividend, TDivisor> result = fast_divmod(dividend, divisor);
+  CHECK_RESULT(failures, "fast_divmod.quot", dividend, divisor, (TDividend)(dividend/divisor), result.quot);
+  CHECK_RESULT(failures, "fast_divmod.rem", dividend, divisor, (TDivisor)(dividend%divisor), result.rem);
+  CHECK_RESULT(failures, "fast_mod", dividend, divisor, (TDivisor)(dividend%divisor), fast_mod(dividend, divisor));
+}
+
+static void check_div_ct(uint32_t dividend, uint32_t divisor, sweep_failures_t &failures) {
+  CHECK_RESULT(failures, "fast_div_ct", dividend, divisor, dividend/divisor, fast_div_ct(dividend, divisor));
+}
+
+// ===================== Exhaustive =====================
+
+static void test_exhaustive_u8_u8(void) {
+  sweep_failures_t failures = { 0U, "" };
+  for (uint16_t dividend=0U; dividend<=UINT8_MAX; ++dividend) {
+    for (uint16_t divisor=1U; divisor<=UINT8_MAX; ++divisor) {
+      check_divmod((uint8_t)dividend, (uint8_t)divisor, failures);
+    }
+  }
+  ASSERT_NO_FAILURES(failures);
+}
+
+static void test_exhaustive_u16_u8(void) {
+  sweep_failures_t failures = { 0U, "" };
+  for (uint32_t dividend=0U; dividend<=UINT16_MAX; ++dividend) {
+    CHECK_RESULT(failures, "fast_div", (uint16_t)dividend, (uint8_t)0U, (uint16_t)0U, fast_div((uint16_t)dividend, (uint8_t)0U));
+    for (uint16_t divisor=1U; divisor<=UINT8_MAX; ++divisor) {
+      check_divmod((uint16_t)dividend, (uint8_t)divisor, failures);
+
+      uint8_t checked;
+      const uint16_t quot = (uint16_t)(dividend/divisor);
+      const bool fits = fast_div16_8_checked((uint16_t)dividend, (uint8_t)divisor, checked);
+      CHECK_RESULT(failures, "fast_div16_8_checked", (uint16_t)dividend, (uint8_t)divisor, (quot<=UINT8_MAX), fits);
+      CHECK_RESULT(failures, "fast_div16_8_sat", (uint16_t)dividend, (uint8_t)divisor, (uint8_t)(quot<=UINT8_MAX ? quot : UINT8_MAX), checked);
+    }
+  }
+  ASSERT_NO_FAILURES(failures);
+}
+
+static void test_exhaustive_s16_s8(void) {
+  sweep_failures_t failures = { 0U, "" };
+  for (int32_t dividend=INT16_MIN; dividend<=INT16_MAX; ++dividend) {
+    for (int16_t divisor=INT8_MIN; divisor<=INT8_MAX; ++divisor) {
+      if (divisor!=0) {
+        check_divmod((int16_t)dividend, (int8_t)divisor, failures);
+      }
+    }
+  }
+  ASSERT_NO_FAILURES(failures);
+}
+
+// Both operand orders, against the mathematical quotient
+static void test_exhaustive_mixed_16_8(void) {
+  sweep_failures_t failures = { 0U, "" };
+  for (int32_t dividend=INT16_MIN; dividend<=INT16_MAX; ++dividend) {
+    for (uint16_t divisor=1U; divisor<=UINT8_MAX; ++divisor) {
+      CHECK_RESULT(failures, "fast_div_mixed", (int16_t)dividend, (int16_t)divisor, (int16_t)(dividend/(int32_t)divisor), fast_div_mixed((int16_t)dividend, (uint8_t)divisor));
+    }
+  }
+  for (uint32_t dividend=0U; dividend<=UINT16_MAX; ++dividend) {
+    for (int16_t divisor=INT8_MIN; divisor<=INT8_MAX; ++divisor) {
+      if (divisor!=0) {
+        CHECK_RESULT(failures, "fast_div_mixed", (int32_t)dividend, (int32_t)divisor, (int32_t)dividend/divisor, fast_div_mixed((uint16_t)dividend, (int8_t)divisor));
+      }
+    }
+  }
+  ASSERT_NO_FAILURES(failures);
+}
+
+static void test_exhaustive_u16_u16(void) {
+  sweep_failures_t failures = { 0U, "" };
+  for (uint32_t dividend=0U; dividend<=UINT16_MAX; ++dividend) {
+    for (uint32_t divisor=1U; divisor<=UINT16_MAX; ++divisor) {
+      check_divmod((uint16_t)dividend, (uint16_t)divisor, failures);
+    }
+  }
+  ASSERT_NO_FAILURES(failures);
+}
+
+// ===================== Boundary =====================
+
+// Values around every power of two, plus the type limits & alternating bit patterns.
+// Returns the number of values written
+template <typename T>
+static size_t boundary_values(T *pValues) {
+  using unsigned_t = type_traits::make_unsigned_t<T>;
+  static constexpr uint8_t bits = (uint8_t)(sizeof(T)*8U);
+  const unsigned_t max = (unsigned_t)~(unsigned_t)0U;
+
+  size_t count = 0U;
+  pValues[count++] = 0U;
+  for (uint8_t bit=0U; bit<bits; ++bit) {
+    const unsigned_t power = (unsigned_t)((unsigned_t)1U << bit);
+    pValues[count++] = (T)(power-1U);
+    pValues[count++] = (T)power;
+    pValues[count++] = (T)(power+1U);
+  }
+  pValues[count++] = (T)(max-1U);
+  pValues[count++] = (T)max;
+  pValues[count++] = (T)(max/3U);        // 0x55...
+  pValues[count++] = (T)(max-(max/3U));  // 0xAA...
+  return count;
+}
+
+template <typename TDividend, typename TDivisor>
+static void boundary_sweep(sweep_failures_t &failures, void (*pCheck)(TDividend, TDivisor, sweep_failures_t&)) {
+  using unsigned_t = type_traits::make_unsigned_t<TDividend>;
+  TDividend dividends[(sizeof(TDividend)*8U*3U)+8U];
+  const size_t dividendCount = boundary_values(dividends);
+  TDivisor divisors[(sizeof(TDivisor)*8U*3U)+8U];
+  const size_t divisorCount = boundary_values(divisors);
+
+  for (size_t divisorIndex=0U; divisorIndex<divisorCount; ++divisorIndex) {
+    const TDivisor divisor = divisors[divisorIndex];
+    if (divisor==0U) {
+      continue;
+    }
+    for (size_t dividendIndex=0U; dividendIndex<dividendCount; ++dividendIndex) {
+      pCheck(dividends[dividendIndex], divisor, failures);
+      // Dividends either side of an exact multiple: these land on the edges
+      // of each fast path
+      const TDividend product = (TDividend)((unsigned_t)dividends[dividendIndex]*(unsigned_t)(TDividend)divisor);
+      if (!is_overflow(product, divisor) && (product/divisor==dividends[dividendIndex])) {
+        pCheck(product, divisor, failures);
+        pCheck((TDividend)((unsigned_t)product-1U), divisor, failures);
+        pCheck((TDividend)((unsigned_t)product+(unsigned_t)(TDividend)(divisor-1)), divisor, failures);
+      }
+    }
+  }
+}
+
+// ===================== Random =====================
+
+// splitmix64: fast, seedable & good enough to spread cases
+static uint64_t next_random(uint64_t &state) {
+  uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+  value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31U);
+}
+
+// Uniform values almost always give a quotient of 0 or 1, so also
+// randomize the magnitude
+template <typename T>
+static T random_value(uint64_t &state) {
+  const uint64_t value = next_random(state);
+  return (T)(value >> (value & 0x3FU));
+}
+
+template <typename TDividend, typename TDivisor>
+static void random_sweep(sweep_failures_t &failures, uint64_t iterations, void (*pCheck)(TDividend, TDivisor, sweep_failures_t&)) {
+  uint64_t state = 0x5EED0000ULL + (sizeof(TDividend)*8U) + sizeof(TDivisor);
+  for (uint64_t index=0U; index<iterations; ++index) {
+    const TDividend dividend = (index & 1U) ? (TDividend)next_random(state) : random_value<TDividend>(state);
+    const TDivisor divisor = random_value<TDivisor>(state);
+    if (divisor!=0U) {
+      pCheck(dividend, divisor, failures);
+    }
+  }
+}
+
+template <typename TDividend, typename TDivisor>
+static void sweep(uint64_t iterations, void (*pCheck)(TDividend, TDivisor, sweep_failures_t&)) {
+  sweep_failures_t failures = { 0U, "" };
+  boundary_sweep<TDividend, TDivisor>(failures, pCheck);
+  random_sweep<TDividend, TDivisor>(failures, iterations, pCheck);
+  ASSERT_NO_FAILURES(failures);
+}
+
+static void test_sweep_u32_u8(void) {
+  sweep<uint32_t, uint8_t>(NATIVE_RANDOM_ITERATIONS, check_divmod);
+}
+
+static void test_sweep_u32_u16(void) {
+  sweep<uint32_t, uint16_t>(NATIVE_RANDOM_ITERATIONS, check_divmod);
+}
+
+static void test_sweep_u32_u32(void) {
+  sweep<uint32_t, uint32_t>(NATIVE_RANDOM_ITERATIONS, check_divmod);
+}
+
+static void test_sweep_ct_u32_u32(void) {
+  sweep<uint32_t, uint32_t>(NATIVE_RANDOM_ITERATIONS, check_div_ct);
+}
+
+static void test_sweep_s32_s16(void) {
+  sweep<int32_t, int16_t>(NATIVE_RANDOM_ITERATIONS/4U, check_divmod);
+}
+
+static void test_sweep_s32_s32(void) {
+  sweep<int32_t, int32_t>(NATIVE_RANDOM_ITERATIONS/4U, check_divmod);
+}
+
+static void test_sweep_u64_u32(void) {
+  sweep<uint64_t, uint32_t>(NATIVE_RANDOM_ITERATIONS/8U, check_div);
+}
+
+static void test_sweep_u64_u64(void) {
+  sweep<uint64_t, uint64_t>(NATIVE_RANDOM_ITERATIONS/8U, check_div);
+}
+
+void test_native_sweep(void) {
+  RUN_TEST(test_exhaustive_u8_u8);
+  RUN_TEST(test_exhaustive_u16_u8);
+  RUN_TEST(test_exhaustive_s16_s8);
+  RUN_TEST(test_exhaustive_mixed_16_8);
+  RUN_TEST(test_exhaustive_u16_u16);
+  RUN_TEST(test_sweep_u32_u8);
+  RUN_TEST(test_sweep_u32_u16);
+  RUN_TEST(test_sweep_u32_u32);
+  RUN_TEST(test_sweep_ct_u32_u32);
+  RUN_TEST(test_sweep_s32_s16);
+  RUN_TEST(test_sweep_s32_s32);
+  RUN_TEST(test_sweep_u64_u32);
+  RUN_TEST(test_sweep_u64_u64);
+}
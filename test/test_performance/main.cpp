@@ -6,6 +6,7 @@ extern void test_implementation_details(void);
 extern void test_implementation_performance(void);
 extern void test_fast_div(void);
 extern void test_fast_div_performance(void);
+extern void test_wcet_performance(void);
 
 void setup()
 {
@@ -30,6 +31,7 @@ void setup()
     Serial.println("Testing Public API");
     Serial.println("------------------");
     test_fast_div_performance();
+    test_wcet_performance();
     UNITY_END(); 
     
     // Tell SimAVR we are done
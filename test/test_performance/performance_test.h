@@ -13,14 +13,56 @@ void dump(const index_range_generator<T> &gen) {
 }
 #endif
 
+template <typename T>
+static inline bool is_negative(T value, const type_traits::true_type&) {
+  return value<0;
+}
+template <typename T>
+static inline bool is_negative(T, const type_traits::false_type&) {
+  return false;
+}
+
+// AVR printf() can't format 64-bit values, so do it ourselves. 
+// Returns a pointer to the terminating null.
+template <typename T>
+static inline char* format_decimal(char *pBuffer, T value) {
+  using unsigned_t = type_traits::make_unsigned_t<T>;
+  unsigned_t magnitude = (unsigned_t)value;
+  if (is_negative(value, type_traits::is_signed<T>())) {
+    *pBuffer++ = '-';
+    magnitude = (unsigned_t)(0U-magnitude);
+  }
+  char digits[20];
+  uint8_t count = 0U;
+  do {
+    digits[count++] = (char)('0' + (uint8_t)(magnitude % 10U));
+    magnitude = (unsigned_t)(magnitude / 10U);
+  } while (magnitude!=0U);
+  while (count!=0U) {
+    *pBuffer++ = digits[--count];
+  }
+  *pBuffer = '\0';
+  return pBuffer;
+}
+
+// Format a range as "min..max"
+template <typename T>
+static inline void format_range(char *pBuffer, const index_range_generator<T> &range) {
+  pBuffer = format_decimal(pBuffer, range.rangeMin());
+  *pBuffer++ = '.';
+  *pBuffer++ = '.';
+  format_decimal(pBuffer, range.rangeMax());
+}
+
+// percentExpected for tests without a simavr measured threshold yet: the test
+// still checks the results agree & emits its AFD_CYCLES row, but doesn't assert
+// on the cycle count. Set a threshold from the measured ratio plus a margin.
+static constexpr uint8_t REPORT_ONLY = 0U;
+
 template <typename T, typename U>
 static inline void performance_test(uint16_t iters, 
   const index_range_generator<T> &dividendRange, 
-#if defined(DETAILED_MESSAGES)
   const index_range_generator<U> &divisorRange, 
-#else
-  const index_range_generator<U> &, 
-#endif
   void (*pTestFunA)(uint16_t, uint32_t&), 
   void (*pTestFunB)(uint16_t, uint32_t&),
   uint8_t percentExpected) {
@@ -36,12 +78,23 @@ SET_UNITY_FILENAME() {
     auto comparison = compare_executiontime<uint16_t, uint32_t>(iters, 0U, dividendRange.num_steps(), 1U, pTestFunA, pTestFunB);
     
     MESSAGE_TIMERS(comparison.timeA.timer, comparison.timeB.timer);
+
+    char dividendText[48];
+    format_range(dividendText, dividendRange);
+    char divisorText[48];
+    format_range(divisorText, divisorRange);
+    MESSAGE_CYCLES(Unity.CurrentTestName, dividendText, divisorText, comparison.timeA.cycles, comparison.timeB.cycles);
     TEST_ASSERT_EQUAL(comparison.timeA.result, comparison.timeB.result);
 
   #if (__AVR__)
-    auto expectedTime = (comparison.timeA.timer.duration_micros()/100U)*percentExpected;
+    if (percentExpected==REPORT_ONLY) {
+      return;
+    }
+    // Timer1 cycles count only the calls themselves: unlike duration_micros(),
+    // the loop and timer overhead doesn't dilute the ratio
+    uint32_t expectedCycles = (comparison.timeA.cycles.duration_cycles()/100U)*percentExpected;
 
-    TEST_ASSERT_LESS_THAN(expectedTime, comparison.timeB.timer.duration_micros());
+    TEST_ASSERT_LESS_THAN_UINT32(expectedCycles, comparison.timeB.cycles.duration_cycles());
   #endif
   }
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include <Arduino.h>
 #include <unity.h>
 #include "avr-fast-div.h"
+#include "afd_divisor.h"
+#include "afd_array.h"
+#include "afd_range.h"
+#include "afd_isr.h"
+#include "afd_interpolate.h"
 #include "../lambda_timer.hpp"
 #include "../unity_print_timers.hpp"
 #include "../test_utils.h"
@@ -37,6 +42,22 @@ static void performance_test(uint16_t iters, const index_range_generator<T> &div
   performance_test(iters, dividendRange, divisorRange, nativeTest, optimizedTest, percentExpected); 
 }
 
+template <typename T, typename U>
+static void performance_test_mod(uint16_t iters, const index_range_generator<T> &dividendRange, const index_range_generator<U> &divisorRange, uint8_t percentExpected) {
+  static const index_range_generator<T> *pDividendRange;
+  pDividendRange = &dividendRange;
+  static const index_range_generator<U> *pDivisorRange;
+  pDivisorRange = &divisorRange;
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += pDividendRange->generate(index) % pDivisorRange->generate(index);
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_mod(pDividendRange->generate(index), pDivisorRange->generate(index));
+  };
+  performance_test(iters, dividendRange, divisorRange, nativeTest, optimizedTest, percentExpected); 
+}
+
 static void test_fast_div_perf_u16_u8_optimal(void)
 {
   // Tests the optimal scenario: all results of u16/u8 fit into a u8
@@ -78,6 +99,15 @@ static void test_fast_div_perf_u32_u8(void)
   performance_test(16, dividendGen, divisorGen, percentExpected);
 }
 
+static void test_fast_div_perf_u32_u8_large_quotient(void)
+{
+  // Quotients wider than 16 bits: the u32/u8=>u24 kernel rather than the division operator
+  static constexpr index_range_generator<uint8_t> divisorGen(128U, UINT8_MAX-2U, 125U);
+  static constexpr index_range_generator<uint32_t> dividendGen((uint32_t)UINT16_MAX*UINT8_MAX, (uint32_t)INT32_MAX, divisorGen.num_steps()); 
+
+  performance_test(16, dividendGen, divisorGen, REPORT_ONLY);
+}
+
 static void test_fast_div_perf_u32_u16_optimal(void)
 {
   // Tests the optimal scenario: all results of u32/u16 fit into a u16
@@ -106,6 +136,50 @@ static void test_fast_div_perf_u32_u16_worst_case(void)
   performance_test(11, dividendGen, divisorGen, percentExpected);
 }
 
+// Power of two divisors: 1, 2, 4...32768. With AFD_POW2_DIVISOR, these are shifts.
+static const uint16_t pow2Divisors[16] = { 
+  1U, 2U, 4U, 8U, 16U, 32U, 64U, 128U, 256U, 512U, 1024U, 2048U, 4096U, 8192U, 16384U, 32768U };
+// Their neighbours, which pay for the AFD_POW2_DIVISOR test but still use the kernel
+static const uint16_t nonPow2Divisors[16] = {
+  3U, 5U, 7U, 9U, 17U, 33U, 65U, 129U, 257U, 513U, 1025U, 2049U, 4097U, 8193U, 16385U, 32769U };
+
+static void test_fast_div_perf_u32_u16_pow2(void)
+{
+#if defined(AFD_POW2_DIVISOR)
+  TEST_MESSAGE("Power of two divisor detection");
+#endif
+  static constexpr index_range_generator<uint32_t> dividendGen(0U, UINT32_MAX, 3333U);
+  static constexpr index_range_generator<uint16_t> divisorGen(1U, 32768U, dividendGen.num_steps());
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += dividendGen.generate(index) / pow2Divisors[index & 15U];
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_div(dividendGen.generate(index), pow2Divisors[index & 15U]);
+  };
+
+  // Without AFD_POW2_DIVISOR, only ~6% of the quotients fit into 16-bits
+  // (dividend < divisor * 65536): the rest take the native fallback
+  performance_test(4, dividendGen, divisorGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
+static void test_fast_div_perf_u32_u16_not_pow2(void)
+{
+  // All quotients fit into 16-bits, so this measures the kernel plus the cost of
+  // the AFD_POW2_DIVISOR test. Compare with & without AFD_POW2_DIVISOR.
+  static constexpr index_range_generator<uint32_t> dividendGen(0U, 3UL*UINT16_MAX, 3333U);
+  static constexpr index_range_generator<uint16_t> divisorGen(3U, 32769U, dividendGen.num_steps());
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += dividendGen.generate(index) / nonPow2Divisors[index & 15U];
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_div(dividendGen.generate(index), nonPow2Divisors[index & 15U]);
+  };
+
+  performance_test(4, dividendGen, divisorGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
 static void test_fast_div_perf_u16_u16(void)
 {
   static constexpr index_range_generator<uint16_t> divisorGen(1U, UINT16_MAX/2U, 3333U);
@@ -127,8 +201,24 @@ static void test_fast_div_perf_u16_u16(void)
   performance_test(3, dividendGen, divisorGen, percentExpected);
 }
 
+// Large divisors only: the divmod_large_divisor() path. Compare the CI runs with &
+// without AFD_NEWTON_RAPHSON to benchmark the two implementations.
+static void test_fast_div_perf_u16_u16_large_divisor(void)
+{
+#if defined(AFD_NEWTON_RAPHSON)
+  TEST_MESSAGE("Newton-Raphson reciprocal");
+#endif
+  static constexpr index_range_generator<uint16_t> divisorGen(UINT8_MAX+1U, UINT16_MAX/2U, 3333U);
+  static constexpr index_range_generator<uint16_t> dividendGen(divisorGen.rangeMax()+1U, UINT16_MAX, divisorGen.num_steps());
+
+  performance_test(3, dividendGen, divisorGen, REPORT_ONLY);
+}
+
 static void test_fast_div_perf_u32_u32(void)
 {
+#if defined(AFD_NEWTON_RAPHSON)
+  TEST_MESSAGE("Newton-Raphson reciprocal");
+#endif
   static constexpr index_range_generator<uint32_t> divisorGen(UINT16_MAX, UINT32_MAX/33UL, 3333U);
   static constexpr index_range_generator<uint32_t> dividendGen((UINT32_MAX/33UL)*2ULL, UINT32_MAX, divisorGen.num_steps());
 
@@ -140,6 +230,47 @@ static void test_fast_div_perf_u32_u32(void)
   performance_test(1, dividendGen, divisorGen, percentExpected);
 }
 
+// Divisors in [2^divisorBits, 2^(divisorBits+1)), dividends above that.
+// The larger the divisor, the fewer quotient bits need computing.
+template <typename T>
+static void performance_test_magnitude(uint8_t divisorBits, uint8_t percentExpected)
+{
+  char buffer[64];
+  sprintf(buffer, "Divisor magnitude: 2^%" PRIu8, divisorBits);
+  TEST_MESSAGE(buffer);
+
+  const index_range_generator<T> divisorGen((T)((T)1U << divisorBits), (T)((T)((T)1U << divisorBits)*2U - 1U), 333U);
+  const index_range_generator<T> dividendGen(divisorGen.rangeMax(), (T)~(T)0U, divisorGen.num_steps());
+  performance_test(2, dividendGen, divisorGen, percentExpected);
+}
+
+static void test_fast_div_perf_u64_u64_by_magnitude(void)
+{
+  performance_test_magnitude<uint64_t>(32U, REPORT_ONLY);
+  performance_test_magnitude<uint64_t>(40U, REPORT_ONLY);
+  performance_test_magnitude<uint64_t>(48U, REPORT_ONLY);
+  performance_test_magnitude<uint64_t>(56U, REPORT_ONLY);
+}
+
+static void test_fast_div_perf_u64_u32(void)
+{
+  // Microsecond timestamps (~12 days) divided by a u32
+  static constexpr index_range_generator<uint32_t> divisorGen(1000U, 1000000UL, 333U);
+  static constexpr index_range_generator<uint64_t> dividendGen((uint64_t)UINT32_MAX+1U, 1ULL << 40U, divisorGen.num_steps());
+
+  performance_test(4, dividendGen, divisorGen, REPORT_ONLY);
+}
+
+#if defined(AFD_HAS_INT24)
+static void test_fast_div_perf_u24_u16(void)
+{
+  static constexpr index_range_generator<uint16_t> divisorGen(2U, UINT16_MAX, 333U);
+  static constexpr index_range_generator<__uint24> dividendGen(UINT16_MAX, __UINT24_MAX__, divisorGen.num_steps());
+
+  performance_test(8, dividendGen, divisorGen, REPORT_ONLY);
+}
+#endif
+
 static void test_fast_div_perf_s32_s16_optimal(void)
 {
   static constexpr index_range_generator<int16_t> divisorGen(INT16_MIN+1L, INT16_MAX, 3333U);
@@ -174,17 +305,323 @@ static void test_fast_div_perf_s32_s16_worst_case(void)
   performance_test(32, dividendGen, divisorGen, percentExpected);
 }
 
+static void test_fast_mod_perf_u32_u16_optimal(void)
+{
+  // Tests the optimal scenario: all results of u32/u16 fit into a u16
+  static constexpr index_range_generator<uint16_t> divisorGen(2U, UINT16_MAX, 333U);
+  static constexpr index_range_generator<uint32_t> dividendGen = create_optimal_dividend_range<uint16_t, uint32_t>(divisorGen); 
+
+  performance_test_mod(12, dividendGen, divisorGen, REPORT_ONLY);
+}
+
+static void test_fast_mod_perf_u32_u16_worst_case(void)
+{
+  // Tests the worst case scenario: none results of u32/u16 fit into a u16.
+  // The upper word is reduced first.
+  static constexpr index_range_generator<uint16_t> divisorGen(2U, UINT16_MAX-2U, 333U);
+  static constexpr index_range_generator<uint32_t> dividendGen(divisorGen.rangeMax()*2ULL, UINT32_MAX, divisorGen.num_steps());
+
+  performance_test_mod(11, dividendGen, divisorGen, REPORT_ONLY);
+}
+static void test_afd_divisor_perf_u32_u16(void)
+{
+  // Tests the invariant divisor scenario: many dividends, one divisor
+  static constexpr index_range_generator<uint32_t> dividendGen(UINT16_MAX, UINT32_MAX/7U, 3333U);
+  // Prevent the compiler optimizing the native division by a constant
+  static volatile uint16_t divisorSource = 7715U;
+  static uint16_t divisor;
+  divisor = divisorSource;
+  static const afd_divisor<uint16_t> precomputed(divisor);
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += dividendGen.generate(index) / divisor;
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_div(dividendGen.generate(index), precomputed);
+  };
+
+  performance_test(4, dividendGen, dividendGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+static void test_afd_range_perf_u32_u32(void)
+{
+  // Tooth time & RPM: both u32, but the ranges guarantee the u32/u16 kernel applies.
+  // The baseline is fast_div() itself: this measures the dispatch that's skipped
+  static constexpr index_range_generator<uint32_t> divisorGen(65U, UINT16_MAX, 3333U);
+  static constexpr index_range_generator<uint32_t> dividendGen(0U, 3600000UL, divisorGen.num_steps());
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += fast_div(dividendGen.generate(index), divisorGen.generate(index));
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_div<afd_range<0, 3600000UL>, afd_range<65U, UINT16_MAX>>(dividendGen.generate(index), divisorGen.generate(index));
+  };
+
+  performance_test(4, dividendGen, divisorGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
+static void test_fast_div_isr_perf_u32_u16(void)
+{
+  // The same workload as test_fast_div_perf_u32_u16_optimal
+  static constexpr index_range_generator<uint16_t> divisorGen(2U, UINT16_MAX, 333U);
+  static constexpr index_range_generator<uint32_t> dividendGen = create_optimal_dividend_range<uint16_t, uint32_t>(divisorGen); 
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += dividendGen.generate(index) / divisorGen.generate(index);
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_div_isr(dividendGen.generate(index), divisorGen.generate(index));
+  };
+
+  performance_test(12, dividendGen, divisorGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
+static void test_fast_div_array_perf_u32_u16(void)
+{
+  // One divisor per batch of dividends
+  static constexpr index_range_generator<uint16_t> divisorGen(2U, UINT16_MAX, 333U);
+  static constexpr uint8_t batchSize = 16U;
+  static uint32_t dividends[batchSize];
+  for (uint8_t index=0U; index<batchSize; ++index) {
+    dividends[index] = UINT32_MAX/(index+1U);
+  }
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    const uint16_t divisor = divisorGen.generate(index);
+    for (uint8_t element=0U; element<batchSize; ++element) {
+      checkSum += dividends[element] / divisor;
+    }
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    uint32_t results[batchSize];
+    fast_div_array(dividends, divisorGen.generate(index), results, batchSize);
+    for (uint8_t element=0U; element<batchSize; ++element) {
+      checkSum += results[element];
+    }
+  };
+
+  performance_test(1, divisorGen, divisorGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
+static void test_fast_muldiv_perf_u16_u16(void)
+{
+  // Scaling: a*b/c, where the result fits into a u16
+  static constexpr index_range_generator<uint16_t> aGen(1000U, 60000U, 333U);
+  static constexpr index_range_generator<uint16_t> cGen(50000U, UINT16_MAX, aGen.num_steps());
+  // Prevent the compiler optimizing the multiply by a constant
+  static volatile uint16_t bSource = 50000U;
+  static uint16_t b;
+  b = bSource;
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += (uint16_t)(((uint32_t)aGen.generate(index) * b) / cGen.generate(index));
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_muldiv(aGen.generate(index), b, cGen.generate(index));
+  };
+
+  performance_test(8, aGen, cGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
+static void test_fast_div_fixed_perf_q8_8(void)
+{
+  // Q8.8 ratios less than 1: pure fractions
+  static constexpr index_range_generator<uint16_t> divisorGen(1000U, UINT16_MAX, 333U);
+  static constexpr index_range_generator<uint16_t> dividendGen(1U, 999U, divisorGen.num_steps());
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += fast_div((uint32_t)dividendGen.generate(index) << 8U, (uint32_t)divisorGen.generate(index));
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_div_fixed<8>(dividendGen.generate(index), divisorGen.generate(index));
+  };
+
+  performance_test(8, dividendGen, divisorGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
+static void test_fast_div_round_perf_u32_u16(void)
+{
+  // Tests the optimal scenario: all results of u32/u16 fit into a u16
+  static constexpr index_range_generator<uint16_t> divisorGen(2U, UINT16_MAX, 333U);
+  static constexpr index_range_generator<uint32_t> dividendGen = create_optimal_dividend_range<uint16_t, uint32_t>(divisorGen); 
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    const uint16_t divisor = divisorGen.generate(index);
+    checkSum += (dividendGen.generate(index) + (divisor/2U)) / divisor;
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_div_round(dividendGen.generate(index), divisorGen.generate(index));
+  };
+
+  performance_test(8, dividendGen, divisorGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
+static void test_fast_div_mixed_perf_s16_u8(void)
+{
+  static constexpr index_range_generator<uint8_t> divisorGen(1U, UINT8_MAX, 127U);
+  static constexpr index_range_generator<int16_t> dividendGen(INT16_MIN+1, INT16_MAX, divisorGen.num_steps());
+
+  // The correct native expression: both sides promoted to a wider signed type
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += (uint32_t)(int16_t)((int32_t)dividendGen.generate(index) / (int32_t)divisorGen.generate(index));
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += (uint32_t)fast_div_mixed(dividendGen.generate(index), divisorGen.generate(index));
+  };
+
+  performance_test(8, dividendGen, divisorGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
+// A 4x4 VE table, for the interpolation tests
+static const uint16_t interpRpmAxis[] = { 500U, 1500U, 3000U, 6000U };
+static const uint16_t interpLoadAxis[] = { 2000U, 5000U, 10000U, 20000U };
+static const uint8_t interpVeTable[] = {
+   30U,  60U,  90U, 120U,
+   50U, 100U, 255U, 140U,
+   70U,   0U, 200U, 160U,
+   90U, 110U, 130U, 150U,
+};
+
+static void test_fast_interpolate2d_perf_u16_u8(void)
+{
+  // A VE table lookup at steady state: every lookup lands in the same bins
+  static constexpr index_range_generator<uint16_t> rpmGen(1600U, 2900U, 311U);
+  static constexpr index_range_generator<uint16_t> loadGen(5500U, 9500U, rpmGen.num_steps());
+  static afd_interp_bin<uint16_t, uint8_t> rpmBin, loadBin;
+
+  // The usual scalar code: signed 32-bit intermediates
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    const int32_t rpm = rpmGen.generate(index);
+    const int32_t load = loadGen.generate(index);
+    uint8_t x = 0U;
+    while (x<2U && rpm>interpRpmAxis[x+1U]) { ++x; }
+    uint8_t y = 0U;
+    while (y<2U && load>interpLoadAxis[y+1U]) { ++y; }
+    const uint8_t *pRow0 = interpVeTable + (y*4U) + x;
+    const uint8_t *pRow1 = pRow0 + 4U;
+    const int32_t top = pRow0[0] + ((rpm-interpRpmAxis[x])*(pRow0[1]-pRow0[0]))/(interpRpmAxis[x+1U]-interpRpmAxis[x]);
+    const int32_t bottom = pRow1[0] + ((rpm-interpRpmAxis[x])*(pRow1[1]-pRow1[0]))/(interpRpmAxis[x+1U]-interpRpmAxis[x]);
+    checkSum += (uint32_t)(top + ((load-interpLoadAxis[y])*(bottom-top))/(interpLoadAxis[y+1U]-interpLoadAxis[y]));
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_interpolate2d(interpRpmAxis, 4U, interpLoadAxis, 4U, interpVeTable, rpmGen.generate(index), loadGen.generate(index), rpmBin, loadBin);
+  };
+
+  performance_test(4, rpmGen, loadGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
+
+// Cached vs uncached, every lookup in the same bins. With 16-bit axes the cache
+// only skips the axis search, so it must never be slower
+static void test_fast_interpolate2d_perf_cached_u16_u8(void)
+{
+  static constexpr index_range_generator<uint16_t> rpmGen(1600U, 2900U, 311U);
+  static constexpr index_range_generator<uint16_t> loadGen(5500U, 9500U, rpmGen.num_steps());
+  static afd_interp_bin<uint16_t, uint8_t> rpmBin, loadBin;
+
+  static auto uncachedTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += fast_interpolate2d(interpRpmAxis, 4U, interpLoadAxis, 4U, interpVeTable, rpmGen.generate(index), loadGen.generate(index));
+  };
+  static auto cachedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_interpolate2d(interpRpmAxis, 4U, interpLoadAxis, 4U, interpVeTable, rpmGen.generate(index), loadGen.generate(index), rpmBin, loadBin);
+  };
+
+  performance_test(4, rpmGen, loadGen, uncachedTest, cachedTest, REPORT_ONLY);
+}
+
+// As above, but the lookups alternate between 2 bins on each axis (by index parity),
+// so every cached lookup changes bin. That costs the cache test & 3 stores per axis
+static void test_fast_interpolate2d_perf_bin_change_u16_u8(void)
+{
+  static constexpr index_range_generator<uint16_t> rpmGen(1600U, 2900U, 311U);
+  static constexpr index_range_generator<uint16_t> loadGen(5500U, 9500U, rpmGen.num_steps());
+  static afd_interp_bin<uint16_t, uint8_t> rpmBin, loadBin;
+
+  // Odd indices move rpm to [3000, 6000] & load to [10000, 20000]
+  static auto rpm = [] (uint16_t index) -> uint16_t { 
+    return (uint16_t)(rpmGen.generate(index) + ((index & 1U) ? 1500U : 0U));
+  };
+  static auto load = [] (uint16_t index) -> uint16_t { 
+    return (uint16_t)(loadGen.generate(index) + ((index & 1U) ? 5000U : 0U));
+  };
+  static auto uncachedTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += fast_interpolate2d(interpRpmAxis, 4U, interpLoadAxis, 4U, interpVeTable, rpm(index), load(index));
+  };
+  static auto cachedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_interpolate2d(interpRpmAxis, 4U, interpLoadAxis, 4U, interpVeTable, rpm(index), load(index), rpmBin, loadBin);
+  };
+
+  performance_test(4, rpmGen, loadGen, uncachedTest, cachedTest, REPORT_ONLY);
+}
+
+// Cached vs uncached for an 8-bit table, every lookup in the same bins: the
+// cached form multiplies by the bin widths' reciprocals
+static void test_fast_interpolate2d_perf_cached_u8_u8(void)
+{
+  static constexpr index_range_generator<uint8_t> xGen(70U, 110U, 40U);
+  static constexpr index_range_generator<uint8_t> yGen(130U, 240U, xGen.num_steps());
+  static const uint8_t xAxis[] = { 10U, 60U, 120U, 250U };
+  static const uint8_t yAxis[] = { 0U, 100U, 250U, 255U };
+  static afd_interp_bin<uint8_t, uint8_t> xBin, yBin;
+
+  static auto uncachedTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += fast_interpolate2d(xAxis, 4U, yAxis, 4U, interpVeTable, xGen.generate(index), yGen.generate(index));
+  };
+  static auto cachedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_interpolate2d(xAxis, 4U, yAxis, 4U, interpVeTable, xGen.generate(index), yGen.generate(index), xBin, yBin);
+  };
+
+  // 3 u24/u8 kernels (16 steps each) become 3 16-bit multiply-highs
+  performance_test(4, xGen, yGen, uncachedTest, cachedTest, REPORT_ONLY);
+}
+
+static void test_constant_divisor_perf_u32(void)
+{
+  static constexpr index_range_generator<uint32_t> dividendGen(UINT16_MAX, UINT32_MAX/7U, 3333U);
+  static constexpr uint32_t divisor = 7715U;
+
+  static auto nativeTest = [] (uint16_t index, uint32_t &checkSum) { 
+    checkSum += dividendGen.generate(index) / divisor;
+  };
+  static auto optimizedTest = [] (uint16_t index, uint32_t &checkSum) {
+    checkSum += fast_div<divisor>(dividendGen.generate(index));
+  };
+
+  performance_test(4, dividendGen, dividendGen, nativeTest, optimizedTest, REPORT_ONLY);
+}
 
 void test_fast_div_performance(void) {
    SET_UNITY_FILENAME() {
       RUN_TEST(test_fast_div_perf_u16_u8_optimal);
       RUN_TEST(test_fast_div_perf_u16_u8_worst_case);
       RUN_TEST(test_fast_div_perf_u16_u16);
+      RUN_TEST(test_fast_div_perf_u16_u16_large_divisor);
       RUN_TEST(test_fast_div_perf_u32_u8);
+      RUN_TEST(test_fast_div_perf_u32_u8_large_quotient);
       RUN_TEST(test_fast_div_perf_u32_u16_optimal);
       RUN_TEST(test_fast_div_perf_u32_u16_worst_case);
+      RUN_TEST(test_fast_div_perf_u32_u16_pow2);
+      RUN_TEST(test_fast_div_perf_u32_u16_not_pow2);
       RUN_TEST(test_fast_div_perf_u32_u32);
+      RUN_TEST(test_fast_div_perf_u64_u64_by_magnitude);
+      RUN_TEST(test_fast_div_perf_u64_u32);
+#if defined(AFD_HAS_INT24)
+      RUN_TEST(test_fast_div_perf_u24_u16);
+#endif
       RUN_TEST(test_fast_div_perf_s32_s16_optimal);
       RUN_TEST(test_fast_div_perf_s32_s16_worst_case);
+      RUN_TEST(test_fast_mod_perf_u32_u16_optimal);
+      RUN_TEST(test_fast_mod_perf_u32_u16_worst_case);
+      RUN_TEST(test_afd_divisor_perf_u32_u16);
+      RUN_TEST(test_fast_div_array_perf_u32_u16);
+      RUN_TEST(test_afd_range_perf_u32_u32);
+      RUN_TEST(test_fast_div_isr_perf_u32_u16);
+      RUN_TEST(test_fast_muldiv_perf_u16_u16);
+      RUN_TEST(test_fast_div_fixed_perf_q8_8);
+      RUN_TEST(test_fast_div_round_perf_u32_u16);
+      RUN_TEST(test_fast_div_mixed_perf_s16_u8);
+      RUN_TEST(test_fast_interpolate2d_perf_u16_u8);
+      RUN_TEST(test_fast_interpolate2d_perf_cached_u16_u8);
+      RUN_TEST(test_fast_interpolate2d_perf_bin_change_u16_u8);
+      RUN_TEST(test_fast_interpolate2d_perf_cached_u8_u8);
+      RUN_TEST(test_constant_divisor_perf_u32);
   }
 }
\ No newline at end of file
@@ -0,0 +1,327 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "avr-fast-div.h"
+#include "afd_wcet.h"
+#include "../lambda_timer.hpp"
+#include "../unity_print_timers.hpp"
+#include "../test_utils.h"
+#include "performance_test.h"
+
+// The tests here search for the slowest input to each fast_div() overload and
+// report it next to libgcc's worst case, one machine readable row per overload:
+//
+//    AFD_WCET,test,fast cycles,dividend,divisor,native cycles,dividend,divisor,bound
+//
+// The search tries the known slow paths (the full divide() loop, the most align()
+// iterations, the libgcc fallback) plus a pseudo random sweep across magnitudes.
+// The worst case found must not exceed the afd_wcet<> estimate: this is what
+// verifies those estimates for the environment & options under test.
+//
+// fast_div_ct() is reported as AFD_CT,test,cycles,worst cycles,native worst cycles
+#if defined(__AVR__)
+
+template <typename TDividend, typename TDivisor>
+using div_fun_t = TDividend (*)(TDividend, TDivisor);
+
+template <typename TDividend, typename TDivisor>
+struct wcet_t {
+  uint16_t cycles;
+  TDividend dividend;
+  TDivisor divisor;
+};
+
+template <typename TDividend, typename TDivisor>
+static uint16_t measure_cycles(TDividend dividend, TDivisor divisor, div_fun_t<TDividend, TDivisor> pFun) {
+  // The volatiles pin the division between the two timer reads
+  static volatile TDividend vDividend;
+  static volatile TDivisor vDivisor;
+  static volatile TDividend vResult;
+  vDividend = dividend;
+  vDivisor = divisor;
+
+  cycle_timer_t timer;
+  {
+    cycle_counter_scope_t counterScope;
+    timer.reset();
+    timer.start();
+    vResult = pFun(vDividend, vDivisor);
+    timer.stop();
+  }
+  (void)vResult;
+  return (uint16_t)timer.duration_cycles();
+}
+
+template <typename TDividend, typename TDivisor>
+static void measure_wcet(TDividend dividend, TDivisor divisor, div_fun_t<TDividend, TDivisor> pFun, wcet_t<TDividend, TDivisor> &worst) {
+  const uint16_t cycles = measure_cycles(dividend, divisor, pFun);
+  if (cycles>worst.cycles) {
+    worst = { cycles, dividend, divisor };
+  }
+}
+
+// xorshift32: deterministic, so both functions see the same inputs & a worst case is reproducible
+static uint32_t next_random(uint32_t &state) {
+  state ^= state << 13U;
+  state ^= state >> 17U;
+  state ^= state << 5U;
+  return state;
+}
+
+template <typename T>
+struct value_bits {
+  static constexpr uint8_t value = (uint8_t)(sizeof(T) * CHAR_BIT);
+};
+
+template <typename T>
+static constexpr T max_value(void) {
+  return (T)((type_traits::make_unsigned_t<T>)~(type_traits::make_unsigned_t<T>)0U >> (type_traits::is_signed<T>::value ? 1U : 0U));
+}
+
+// A random value of random magnitude, so all bit widths get covered
+template <typename T>
+static T random_value(uint32_t &state) {
+  using unsigned_t = type_traits::make_unsigned_t<T>;
+  const uint64_t bits = ((uint64_t)next_random(state) << 32U) | next_random(state);
+  return (T)((unsigned_t)bits >> (next_random(state) % value_bits<T>::value));
+}
+
+template <typename TDividend, typename TDivisor>
+static wcet_t<TDividend, TDivisor> search_wcet(div_fun_t<TDividend, TDivisor> pFun) {
+  static constexpr TDividend dividendMax = max_value<TDividend>();
+  // The largest value of half the width of TDividend. Above this, divisors take the large divisor path
+  static constexpr TDividend halfMax = (TDividend)(dividendMax >> (value_bits<TDividend>::value/2U));
+  static constexpr TDivisor divisorMax = max_value<TDivisor>();
+
+  wcet_t<TDividend, TDivisor> worst = { 0U, 0U, 0U };
+
+  const TDivisor divisors[] = {
+    1U, 2U, 3U,
+    (TDivisor)(divisorMax/3U),                // 0x55...
+    (TDivisor)(divisorMax >> 1U),
+    (TDivisor)((divisorMax >> 1U)+1U),        // Top bit only
+    divisorMax,
+    (TDivisor)halfMax,                        // Largest small divisor
+    (TDivisor)(halfMax+1U),                   // Smallest large divisor: most align() iterations
+    (TDivisor)(halfMax+2U),
+  };
+  for (size_t index=0U; index<sizeof(divisors)/sizeof(divisors[0]); ++index) {
+    const TDivisor divisor = divisors[index];
+    if (divisor==0U) {
+      continue;
+    }
+    const TDividend dividends[] = {
+      dividendMax,
+      (TDividend)(dividendMax - (dividendMax/3U)),                 // 0xAA...
+      (TDividend)(dividendMax >> 1U),
+      (TDividend)(((TDividend)divisor*halfMax) + (divisor-1U)),  // All ones quotient from the divide() loop
+    };
+    for (size_t dividendIndex=0U; dividendIndex<sizeof(dividends)/sizeof(dividends[0]); ++dividendIndex) {
+      measure_wcet(dividends[dividendIndex], divisor, pFun, worst);
+    }
+  }
+
+  uint32_t state = 0x2545F491UL;
+  for (uint16_t index=0U; index<512U; ++index) {
+    const TDividend dividend = random_value<TDividend>(state);
+    const TDivisor divisor = random_value<TDivisor>(state);
+    if (divisor!=0U) {
+      measure_wcet(dividend, divisor, pFun, worst);
+    }
+  }
+  return worst;
+}
+
+template <typename TDividend, typename TDivisor>
+static void wcet_test(div_fun_t<TDividend, TDivisor> pNative, div_fun_t<TDividend, TDivisor> pFast) {
+  const wcet_t<TDividend, TDivisor> nativeWorst = search_wcet(pNative);
+  const wcet_t<TDividend, TDivisor> fastWorst = search_wcet(pFast);
+  const uint16_t bound = afd_wcet<TDividend, TDivisor>::cycles;
+
+  char fastDividend[24], fastDivisor[24], nativeDividend[24], nativeDivisor[24];
+  format_decimal(fastDividend, fastWorst.dividend);
+  format_decimal(fastDivisor, fastWorst.divisor);
+  format_decimal(nativeDividend, nativeWorst.dividend);
+  format_decimal(nativeDivisor, nativeWorst.divisor);
+
+  char buffer[192];
+  sprintf(buffer, "AFD_WCET,%s,%" PRIu16 ",%s,%s,%" PRIu16 ",%s,%s,%" PRIu16,
+          Unity.CurrentTestName,
+          fastWorst.cycles, fastDividend, fastDivisor,
+          nativeWorst.cycles, nativeDividend, nativeDivisor,
+          bound);
+  TEST_MESSAGE(buffer);
+
+#if defined(__OPTIMIZE__)
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(bound, fastWorst.cycles);
+#endif
+}
+
+static void test_fast_div_wcet_u8_u8(void) {
+  wcet_test<uint8_t, uint8_t>([] (uint8_t a, uint8_t b) -> uint8_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u16_u8(void) {
+  wcet_test<uint16_t, uint8_t>([] (uint16_t a, uint8_t b) -> uint16_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u16_u16(void) {
+  wcet_test<uint16_t, uint16_t>([] (uint16_t a, uint16_t b) -> uint16_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u32_u8(void) {
+  wcet_test<uint32_t, uint8_t>([] (uint32_t a, uint8_t b) -> uint32_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u32_u16(void) {
+  wcet_test<uint32_t, uint16_t>([] (uint32_t a, uint16_t b) -> uint32_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u32_u32(void) {
+  wcet_test<uint32_t, uint32_t>([] (uint32_t a, uint32_t b) -> uint32_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u64_u8(void) {
+  wcet_test<uint64_t, uint8_t>([] (uint64_t a, uint8_t b) -> uint64_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u64_u16(void) {
+  wcet_test<uint64_t, uint16_t>([] (uint64_t a, uint16_t b) -> uint64_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u64_u32(void) {
+  wcet_test<uint64_t, uint32_t>([] (uint64_t a, uint32_t b) -> uint64_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u64_u64(void) {
+  wcet_test<uint64_t, uint64_t>([] (uint64_t a, uint64_t b) -> uint64_t { return a / b; }, fast_div);
+}
+
+#if defined(AFD_HAS_INT24)
+static void test_fast_div_wcet_u24_u8(void) {
+  wcet_test<__uint24, uint8_t>([] (__uint24 a, uint8_t b) -> __uint24 { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u24_u16(void) {
+  wcet_test<__uint24, uint16_t>([] (__uint24 a, uint16_t b) -> __uint24 { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_u24_u24(void) {
+  wcet_test<__uint24, __uint24>([] (__uint24 a, __uint24 b) -> __uint24 { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s24_s8(void) {
+  wcet_test<__int24, int8_t>([] (__int24 a, int8_t b) -> __int24 { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s24_s16(void) {
+  wcet_test<__int24, int16_t>([] (__int24 a, int16_t b) -> __int24 { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s24_s24(void) {
+  wcet_test<__int24, __int24>([] (__int24 a, __int24 b) -> __int24 { return a / b; }, fast_div);
+}
+#endif
+
+static void test_fast_div_wcet_s8_s8(void) {
+  wcet_test<int8_t, int8_t>([] (int8_t a, int8_t b) -> int8_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s16_s8(void) {
+  wcet_test<int16_t, int8_t>([] (int16_t a, int8_t b) -> int16_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s16_s16(void) {
+  wcet_test<int16_t, int16_t>([] (int16_t a, int16_t b) -> int16_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s32_s8(void) {
+  wcet_test<int32_t, int8_t>([] (int32_t a, int8_t b) -> int32_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s32_s16(void) {
+  wcet_test<int32_t, int16_t>([] (int32_t a, int16_t b) -> int32_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s32_s32(void) {
+  wcet_test<int32_t, int32_t>([] (int32_t a, int32_t b) -> int32_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s64_s8(void) {
+  wcet_test<int64_t, int8_t>([] (int64_t a, int8_t b) -> int64_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s64_s16(void) {
+  wcet_test<int64_t, int16_t>([] (int64_t a, int16_t b) -> int64_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s64_s32(void) {
+  wcet_test<int64_t, int32_t>([] (int64_t a, int32_t b) -> int64_t { return a / b; }, fast_div);
+}
+
+static void test_fast_div_wcet_s64_s64(void) {
+  wcet_test<int64_t, int64_t>([] (int64_t a, int64_t b) -> int64_t { return a / b; }, fast_div);
+}
+
+// fast_div_ct() must take the same number of cycles for every input, and 
+// beat the compiler's worst case
+static void test_fast_div_ct_wcet_u32_u32(void) {
+  const wcet_t<uint32_t, uint32_t> nativeWorst = search_wcet<uint32_t, uint32_t>([] (uint32_t a, uint32_t b) -> uint32_t { return a / b; });
+  const wcet_t<uint32_t, uint32_t> ctWorst = search_wcet<uint32_t, uint32_t>(fast_div_ct);
+  const uint16_t ctCycles = measure_cycles<uint32_t, uint32_t>(1U, 1U, fast_div_ct);
+
+  char buffer[128];
+  sprintf(buffer, "AFD_CT,%s,%" PRIu16 ",%" PRIu16 ",%" PRIu16,
+          Unity.CurrentTestName, ctCycles, ctWorst.cycles, nativeWorst.cycles);
+  TEST_MESSAGE(buffer);
+
+  TEST_ASSERT_EQUAL_UINT16(ctCycles, ctWorst.cycles);
+  uint32_t state = 0x9E3779B9UL;
+  for (uint16_t index=0U; index<512U; ++index) {
+    const uint32_t dividend = random_value<uint32_t>(state);
+    const uint32_t divisor = random_value<uint32_t>(state);
+    if (divisor!=0U) {
+      TEST_ASSERT_EQUAL_UINT16(ctCycles, measure_cycles(dividend, divisor, fast_div_ct));
+    }
+  }
+#if defined(__OPTIMIZE__)
+  TEST_ASSERT_LESS_THAN_UINT16(nativeWorst.cycles, ctWorst.cycles);
+#endif
+}
+
+#endif
+
+void test_wcet_performance(void) {
+#if defined(__AVR__)
+   SET_UNITY_FILENAME() {
+      RUN_TEST(test_fast_div_wcet_u8_u8);
+      RUN_TEST(test_fast_div_wcet_u16_u8);
+      RUN_TEST(test_fast_div_wcet_u16_u16);
+      RUN_TEST(test_fast_div_wcet_u32_u8);
+      RUN_TEST(test_fast_div_wcet_u32_u16);
+      RUN_TEST(test_fast_div_wcet_u32_u32);
+      RUN_TEST(test_fast_div_wcet_u64_u8);
+      RUN_TEST(test_fast_div_wcet_u64_u16);
+      RUN_TEST(test_fast_div_wcet_u64_u32);
+      RUN_TEST(test_fast_div_wcet_u64_u64);
+#if defined(AFD_HAS_INT24)
+      RUN_TEST(test_fast_div_wcet_u24_u8);
+      RUN_TEST(test_fast_div_wcet_u24_u16);
+      RUN_TEST(test_fast_div_wcet_u24_u24);
+      RUN_TEST(test_fast_div_wcet_s24_s8);
+      RUN_TEST(test_fast_div_wcet_s24_s16);
+      RUN_TEST(test_fast_div_wcet_s24_s24);
+#endif
+      RUN_TEST(test_fast_div_wcet_s8_s8);
+      RUN_TEST(test_fast_div_wcet_s16_s8);
+      RUN_TEST(test_fast_div_wcet_s16_s16);
+      RUN_TEST(test_fast_div_wcet_s32_s8);
+      RUN_TEST(test_fast_div_wcet_s32_s16);
+      RUN_TEST(test_fast_div_wcet_s32_s32);
+      RUN_TEST(test_fast_div_wcet_s64_s8);
+      RUN_TEST(test_fast_div_wcet_s64_s16);
+      RUN_TEST(test_fast_div_wcet_s64_s32);
+      RUN_TEST(test_fast_div_wcet_s64_s64);
+      RUN_TEST(test_fast_div_ct_wcet_u32_u32);
+  }
+#endif
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <unity.h>
 #include "timer.hpp"
+#include "cycle_timer.hpp"
 
 static inline void MESSAGE_TIMERS(const simple_timer_t &timerA, const simple_timer_t &timerB) {
     auto aTime = timerA.duration_micros();
@@ -11,3 +12,63 @@ static inline void MESSAGE_TIMERS(const simple_timer_t &timerA, const simple_tim
     sprintf(buffer, "Timing: %" PRIu32 ", %" PRIu32 ", %"  PRIu32 "%%", aTime, bTime, percent);
     TEST_MESSAGE(buffer);
 }
+
+// The library options that change code generation, as a key for AFD_CYCLES rows:
+// the same environment is run with different options (E.g. in CI)
+#define AFD_PERF_OPTION(name) "+" #name
+#if defined(AFD_SMALL_TEXT)
+#define AFD_PERF_SMALL_TEXT AFD_PERF_OPTION(SMALL_TEXT)
+#else
+#define AFD_PERF_SMALL_TEXT ""
+#endif
+#if defined(AFD_SMALL_KERNELS)
+#define AFD_PERF_SMALL_KERNELS AFD_PERF_OPTION(SMALL_KERNELS)
+#else
+#define AFD_PERF_SMALL_KERNELS ""
+#endif
+#if defined(AFD_FAST_TEXT)
+#define AFD_PERF_FAST_TEXT AFD_PERF_OPTION(FAST_TEXT)
+#else
+#define AFD_PERF_FAST_TEXT ""
+#endif
+#if defined(AFD_ALIGN_CLZ)
+#define AFD_PERF_ALIGN_CLZ AFD_PERF_OPTION(ALIGN_CLZ)
+#else
+#define AFD_PERF_ALIGN_CLZ ""
+#endif
+#if defined(AFD_PROFILE)
+#define AFD_PERF_PROFILE AFD_PERF_OPTION(PROFILE)
+#else
+#define AFD_PERF_PROFILE ""
+#endif
+#if defined(AFD_RECIPROCAL_TABLE)
+#define AFD_PERF_RECIPROCAL_TABLE AFD_PERF_OPTION(RECIPROCAL_TABLE)
+#else
+#define AFD_PERF_RECIPROCAL_TABLE ""
+#endif
+#if defined(AFD_POW2_DIVISOR)
+#define AFD_PERF_POW2_DIVISOR AFD_PERF_OPTION(POW2_DIVISOR)
+#else
+#define AFD_PERF_POW2_DIVISOR ""
+#endif
+#if defined(AFD_NEWTON_RAPHSON)
+#define AFD_PERF_NEWTON_RAPHSON AFD_PERF_OPTION(NEWTON_RAPHSON)
+#else
+#define AFD_PERF_NEWTON_RAPHSON ""
+#endif
+#define AFD_PERF_CONFIG "base" AFD_PERF_SMALL_TEXT AFD_PERF_SMALL_KERNELS AFD_PERF_FAST_TEXT AFD_PERF_ALIGN_CLZ AFD_PERF_PROFILE \
+                        AFD_PERF_RECIPROCAL_TABLE AFD_PERF_POW2_DIVISOR AFD_PERF_NEWTON_RAPHSON
+
+// Emits one machine readable row per comparison, so a test log can be reduced
+// to a table with: grep -o 'AFD_CYCLES,.*'. afd_perf_compare.py does that &
+// compares the rows against a stored baseline.
+//
+// Columns: test, options, dividend range, divisor range, cycles per call (A), cycles per call (B)
+static inline void MESSAGE_CYCLES(const char *testName, const char *dividendRange, const char *divisorRange,
+                                  const cycle_timer_t &timerA, const cycle_timer_t &timerB) {
+    char buffer[192];
+    sprintf(buffer, "AFD_CYCLES,%s,%s,%s,%s,%" PRIu32 ",%" PRIu32, 
+            testName, AFD_PERF_CONFIG, dividendRange, divisorRange, 
+            timerA.cycles_per_interval(), timerB.cycles_per_interval());
+    TEST_MESSAGE(buffer);
+}